@@ -0,0 +1,161 @@
+/*
+ * bench.h
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#ifndef INICPP_BENCH_H_
+#define INICPP_BENCH_H_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    /** Returns the number of heap allocations performed by this process so far. */
+    std::size_t allocationCount();
+
+    /** Controls the measurement loop of a single benchmark run.
+      * Benchmarks call run() once per iteration and do their work as long as it
+      * returns true:
+      *
+      *     while(state.run())
+      *         doWork();
+      */
+    class State
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        double minTime_;
+        std::size_t iterations_ = 0;
+        std::size_t nextCheck_ = 1;
+        std::size_t bytes_ = 0;
+        std::size_t allocations_ = 0;
+        bool running_ = false;
+        Clock::time_point start_;
+        Clock::time_point pausedAt_;
+        std::size_t pausedAllocations_ = 0;
+        Clock::duration elapsed_ = Clock::duration::zero();
+
+    public:
+        explicit State(const double minTime) : minTime_(minTime)
+        {}
+
+        /** Starts a new iteration. Returns false once enough iterations were
+          * measured. */
+        bool run()
+        {
+            if(!running_)
+            {
+                running_ = true;
+                allocations_ = allocationCount();
+                start_ = Clock::now();
+                return true;
+            }
+
+            ++iterations_;
+            // only look at the clock from time to time, so cheap operations
+            // are not dominated by the cost of reading the time
+            if(iterations_ < nextCheck_)
+                return true;
+
+            elapsed_ = Clock::now() - start_;
+            if(std::chrono::duration<double>(elapsed_).count() < minTime_)
+            {
+                nextCheck_ = iterations_ * 2;
+                return true;
+            }
+
+            allocations_ = allocationCount() - allocations_;
+            running_ = false;
+            return false;
+        }
+
+        /** Stops the clock and the allocation counter, so work which should not
+          * be measured can be done inside an iteration. */
+        void pause()
+        {
+            pausedAt_ = Clock::now();
+            pausedAllocations_ = allocationCount();
+        }
+
+        /** Restarts the clock and the allocation counter after pause(). */
+        void resume()
+        {
+            allocations_ += allocationCount() - pausedAllocations_;
+            start_ += Clock::now() - pausedAt_;
+        }
+
+        /** Sets the number of bytes processed by a single iteration. */
+        void setBytesPerIteration(const std::size_t bytes)
+        {
+            bytes_ = bytes;
+        }
+
+        std::size_t iterations() const
+        {
+            return iterations_;
+        }
+
+        std::size_t bytesPerIteration() const
+        {
+            return bytes_;
+        }
+
+        std::size_t allocations() const
+        {
+            return allocations_;
+        }
+
+        double seconds() const
+        {
+            return std::chrono::duration<double>(elapsed_).count();
+        }
+    };
+
+    using Function = void (*)(State &);
+
+    struct Benchmark
+    {
+        std::string name;
+        Function function;
+    };
+
+    /** Returns the list of all registered benchmarks. */
+    std::vector<Benchmark> &registry();
+
+    /** Registers a benchmark function on construction. */
+    struct Registrar
+    {
+        Registrar(const char *name, Function function)
+        {
+            registry().push_back({name, function});
+        }
+    };
+
+    /** Prevents the compiler from optimizing away the computation of value. */
+    template<typename T>
+    inline void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+/** Registers the given function as benchmark with the given name. */
+#define BENCHMARK(name, function) static bench::Registrar BENCH_CONCAT(benchRegistrar, __LINE__)(name, function)
+
+#endif
@@ -0,0 +1,363 @@
+/*
+ * bench_convert.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <inicpp.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/** Creates the given number of integers formatted by the given function.
+  * The conversions are benchmarked on plain strings, because fields cache
+  * the decoded value. */
+template<typename Format>
+static std::vector<std::string> makeFields(const std::size_t count, Format format)
+{
+    std::vector<std::string> result;
+    for(std::size_t i = 0; i < count; ++i)
+        result.push_back(format(static_cast<long>(i * 7919)));
+    return result;
+}
+
+static void decodeFields(bench::State &state, const std::vector<std::string> &fields)
+{
+    ini::Convert<long> conv;
+    while(state.run())
+    {
+        long sum = 0;
+        for(const std::string &field : fields)
+        {
+            long value;
+            conv.decode(field, value);
+            sum += value;
+        }
+        bench::doNotOptimize(sum);
+    }
+}
+
+static void decodeIntDecimal(bench::State &state)
+{
+    const std::vector<std::string> fields = makeFields(1000, [](const long value) {
+        return std::to_string(value);
+    });
+    decodeFields(state, fields);
+}
+BENCHMARK("convert/decode/int/decimal", decodeIntDecimal);
+
+static void decodeIntHex(bench::State &state)
+{
+    const std::vector<std::string> fields = makeFields(1000, [](const long value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "0x%lx", value);
+        return std::string(buf);
+    });
+    decodeFields(state, fields);
+}
+BENCHMARK("convert/decode/int/hex", decodeIntHex);
+
+static void decodeIntFailure(bench::State &state)
+{
+    const std::vector<std::string> fields = makeFields(1000, [](const long value) {
+        return "value" + std::to_string(value);
+    });
+    ini::Convert<long> conv;
+    while(state.run())
+    {
+        std::size_t failures = 0;
+        for(const std::string &field : fields)
+        {
+            try
+            {
+                long value;
+                conv.decode(field, value);
+                bench::doNotOptimize(value);
+            }
+            catch(const std::invalid_argument &)
+            {
+                ++failures;
+            }
+        }
+        bench::doNotOptimize(failures);
+    }
+}
+BENCHMARK("convert/decode/int/failure", decodeIntFailure);
+
+static void encodeInt(bench::State &state)
+{
+    std::vector<ini::IniField> fields(1000);
+    while(state.run())
+    {
+        for(std::size_t i = 0; i < fields.size(); ++i)
+            fields[i] = static_cast<long>(i * 7919) - 3000000;
+        bench::doNotOptimize(fields);
+    }
+}
+BENCHMARK("convert/encode/int", encodeInt);
+
+static void encodeIntFile(bench::State &state)
+{
+    ini::IniFile inif;
+    for(std::size_t i = 0; i < 100; ++i)
+    {
+        ini::IniSection &sec = inif["section" + std::to_string(i)];
+        for(std::size_t j = 0; j < 100; ++j)
+            sec["key" + std::to_string(j)] = 0;
+    }
+
+    while(state.run())
+    {
+        long value = 0;
+        for(auto &secPair : inif)
+        {
+            for(auto &fieldPair : secPair.second)
+                fieldPair.second = value++ * 7919;
+        }
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("convert/encode/int/file", encodeIntFile);
+
+/** Creates doubles with varying exponents and mantissas. */
+static std::vector<double> makeDoubles(const std::size_t count)
+{
+    std::vector<double> result;
+    double value = 0.1;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        result.push_back(value);
+        value = value * -1.37 + 0.001 * static_cast<double>(i);
+        if(value > 1e12 || value < -1e12)
+            value = 0.3;
+    }
+    return result;
+}
+
+static void encodeDouble(bench::State &state)
+{
+    const std::vector<double> values = makeDoubles(1000);
+    std::vector<ini::IniField> fields(values.size());
+    while(state.run())
+    {
+        for(std::size_t i = 0; i < values.size(); ++i)
+            fields[i] = values[i];
+        bench::doNotOptimize(fields);
+    }
+}
+BENCHMARK("convert/encode/double", encodeDouble);
+
+/** Previous implementation of Convert<double>::encode for comparison. */
+static void encodeDoubleStringstream(bench::State &state)
+{
+    const std::vector<double> values = makeDoubles(1000);
+    std::vector<std::string> results(values.size());
+    while(state.run())
+    {
+        for(std::size_t i = 0; i < values.size(); ++i)
+        {
+            std::stringstream ss;
+            ss << values[i];
+            results[i] = ss.str();
+        }
+        bench::doNotOptimize(results);
+    }
+}
+BENCHMARK("convert/encode/double/stringstream", encodeDoubleStringstream);
+
+static void decodeDouble(bench::State &state)
+{
+    const std::vector<double> values = makeDoubles(1000);
+    std::vector<std::string> strings(values.size());
+    ini::Convert<double> conv;
+    for(std::size_t i = 0; i < values.size(); ++i)
+        conv.encode(values[i], strings[i]);
+
+    while(state.run())
+    {
+        double sum = 0;
+        for(const std::string &str : strings)
+        {
+            double value;
+            conv.decode(str, value);
+            sum += value;
+        }
+        bench::doNotOptimize(sum);
+    }
+}
+BENCHMARK("convert/decode/double", decodeDouble);
+
+/** Previous implementation of Convert<double>::decode for comparison. */
+static void decodeDoubleStod(bench::State &state)
+{
+    const std::vector<double> values = makeDoubles(1000);
+    std::vector<std::string> strings(values.size());
+    for(std::size_t i = 0; i < values.size(); ++i)
+        ini::Convert<double>().encode(values[i], strings[i]);
+
+    while(state.run())
+    {
+        double sum = 0;
+        for(const std::string &str : strings)
+            sum += std::stod(str);
+        bench::doNotOptimize(sum);
+    }
+}
+BENCHMARK("convert/decode/double/stod", decodeDoubleStod);
+
+/** Reads the same field over and over, as done in a request loop. */
+template<typename T>
+static void repeatedAs(bench::State &state, const char *value)
+{
+    ini::IniFile inif;
+    inif["limits"]["max_conns"] = std::string(value);
+    const ini::IniField &field = inif["limits"]["max_conns"];
+    while(state.run())
+    {
+        for(int i = 0; i < 1000; ++i)
+            bench::doNotOptimize(field.as<T>());
+    }
+}
+
+static void repeatedAsInt(bench::State &state)
+{
+    repeatedAs<int>(state, "1024");
+}
+BENCHMARK("convert/repeated/int", repeatedAsInt);
+
+static void repeatedAsDouble(bench::State &state)
+{
+    repeatedAs<double>(state, "0.125");
+}
+BENCHMARK("convert/repeated/double", repeatedAsDouble);
+
+static void repeatedAsBool(bench::State &state)
+{
+    repeatedAs<bool>(state, "true");
+}
+BENCHMARK("convert/repeated/bool", repeatedAsBool);
+
+/** Creates the i-th of a set of varying values of the given type. */
+template<typename T>
+static T makeValue(const std::size_t i)
+{
+    return static_cast<T>(static_cast<long>(i * 7919 % 30000) - (std::is_signed<T>::value ? 15000 : 0));
+}
+
+template<>
+bool makeValue<bool>(const std::size_t i)
+{
+    return i % 2 == 0;
+}
+
+template<>
+char makeValue<char>(const std::size_t i)
+{
+    return static_cast<char>('a' + i % 26);
+}
+
+template<>
+unsigned char makeValue<unsigned char>(const std::size_t i)
+{
+    return static_cast<unsigned char>('a' + i % 26);
+}
+
+template<>
+float makeValue<float>(const std::size_t i)
+{
+    return static_cast<float>(i) * -0.37f;
+}
+
+template<>
+double makeValue<double>(const std::size_t i)
+{
+    return static_cast<double>(i) * 1.37e3;
+}
+
+template<>
+std::string makeValue<std::string>(const std::size_t i)
+{
+    return "value number " + std::to_string(i);
+}
+
+/** Returns 1000 values of the given type encoded by Convert<T>. */
+template<typename T>
+static std::vector<std::string> makeEncodedValues()
+{
+    ini::Convert<T> conv;
+    std::vector<std::string> result(1000);
+    for(std::size_t i = 0; i < result.size(); ++i)
+        conv.encode(makeValue<T>(i), result[i]);
+    return result;
+}
+
+/** Decodes 1000 values with Convert<Target>, the values are created as
+  * Source. */
+template<typename Target, typename Source = Target>
+static void decodeType(bench::State &state)
+{
+    const std::vector<std::string> strings = makeEncodedValues<Source>();
+    ini::Convert<Target> conv;
+    while(state.run())
+    {
+        for(const std::string &str : strings)
+        {
+            Target value = Target();
+            conv.decode(str.data(), str.size(), value);
+            bench::doNotOptimize(value);
+        }
+    }
+}
+
+/** Encodes 1000 values with Convert<T>. */
+template<typename T>
+static void encodeType(bench::State &state)
+{
+    std::vector<T> values;
+    for(std::size_t i = 0; i < 1000; ++i)
+        values.push_back(makeValue<T>(i));
+    ini::Convert<T> conv;
+    std::string result;
+    while(state.run())
+    {
+        for(const T &value : values)
+        {
+            conv.encode(value, result);
+            bench::doNotOptimize(result);
+        }
+    }
+}
+
+BENCHMARK("convert/type/bool/decode", decodeType<bool>);
+BENCHMARK("convert/type/bool/encode", encodeType<bool>);
+BENCHMARK("convert/type/char/decode", decodeType<char>);
+BENCHMARK("convert/type/char/encode", encodeType<char>);
+BENCHMARK("convert/type/unsigned_char/decode", decodeType<unsigned char>);
+BENCHMARK("convert/type/unsigned_char/encode", encodeType<unsigned char>);
+BENCHMARK("convert/type/short/decode", decodeType<short>);
+BENCHMARK("convert/type/short/encode", encodeType<short>);
+BENCHMARK("convert/type/unsigned_short/decode", decodeType<unsigned short>);
+BENCHMARK("convert/type/unsigned_short/encode", encodeType<unsigned short>);
+BENCHMARK("convert/type/int/decode", decodeType<int>);
+BENCHMARK("convert/type/int/encode", encodeType<int>);
+BENCHMARK("convert/type/unsigned_int/decode", decodeType<unsigned int>);
+BENCHMARK("convert/type/unsigned_int/encode", encodeType<unsigned int>);
+BENCHMARK("convert/type/long/decode", decodeType<long>);
+BENCHMARK("convert/type/long/encode", encodeType<long>);
+BENCHMARK("convert/type/unsigned_long/decode", decodeType<unsigned long>);
+BENCHMARK("convert/type/unsigned_long/encode", encodeType<unsigned long>);
+BENCHMARK("convert/type/float/decode", decodeType<float>);
+BENCHMARK("convert/type/float/encode", encodeType<float>);
+BENCHMARK("convert/type/double/decode", decodeType<double>);
+BENCHMARK("convert/type/double/encode", encodeType<double>);
+BENCHMARK("convert/type/string/decode", decodeType<std::string>);
+BENCHMARK("convert/type/string/encode", encodeType<std::string>);
+BENCHMARK("convert/type/const_char_ptr/decode", (decodeType<const char *, std::string>));
+#ifdef __cpp_lib_string_view
+BENCHMARK("convert/type/string_view/decode", (decodeType<std::string_view, std::string>));
+#endif
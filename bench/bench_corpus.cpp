@@ -0,0 +1,194 @@
+/*
+ * bench_corpus.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include "corpus.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <inicpp.h>
+
+/** Returns the corpus configured on the command line without multi-line
+  * values. */
+static const bench::Corpus &corpus()
+{
+    static const bench::Corpus result = []() {
+        bench::CorpusOptions options = bench::corpusOptions();
+        options.multiLineDensity = 0.0;
+        return bench::generateCorpus(options);
+    }();
+    return result;
+}
+
+/** Returns the corpus configured on the command line with multi-line
+  * values. */
+static const bench::Corpus &multiLineCorpus()
+{
+    static const bench::Corpus result = bench::generateCorpus(bench::corpusOptions());
+    return result;
+}
+
+static const char *const corpusFileName = "inicpp_bench_corpus.ini";
+static const char *const corpusSaveFileName = "inicpp_bench_corpus_save.ini";
+
+static void removeCorpusFiles()
+{
+    std::remove(corpusFileName);
+    std::remove(corpusSaveFileName);
+}
+
+static const std::string &corpusFile()
+{
+    static const std::string result = []() {
+        std::atexit(removeCorpusFiles);
+        std::ofstream os(corpusFileName, std::ios::out | std::ios::binary);
+        os.write(corpus().text.data(), static_cast<std::streamsize>(corpus().text.size()));
+        return std::string(corpusFileName);
+    }();
+    return result;
+}
+
+template<typename File>
+static void decodeCorpus(bench::State &state, const bench::Corpus &source, const bool multiLine)
+{
+    state.setBytesPerIteration(source.text.size());
+    File inif;
+    inif.setMultiLineValues(multiLine);
+    while(state.run())
+    {
+        inif.decode(source.text);
+        bench::doNotOptimize(inif);
+    }
+}
+
+static void decodeSensitive(bench::State &state)
+{
+    decodeCorpus<ini::IniFile>(state, corpus(), false);
+}
+BENCHMARK("corpus/decode", decodeSensitive);
+
+static void decodeInsensitive(bench::State &state)
+{
+    decodeCorpus<ini::IniFileCaseInsensitive>(state, corpus(), false);
+}
+BENCHMARK("corpus/decode/insensitive", decodeInsensitive);
+
+static void decodeMultiLine(bench::State &state)
+{
+    decodeCorpus<ini::IniFile>(state, multiLineCorpus(), true);
+}
+BENCHMARK("corpus/decode/multiline", decodeMultiLine);
+
+static void loadCorpus(bench::State &state)
+{
+    const std::string &fileName = corpusFile();
+    state.setBytesPerIteration(corpus().text.size());
+    ini::IniFile inif;
+    while(state.run())
+    {
+        inif.load(fileName);
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("corpus/load", loadCorpus);
+
+static void encodeCorpus(bench::State &state)
+{
+    ini::IniFile inif;
+    inif.decode(corpus().text);
+    state.setBytesPerIteration(corpus().text.size());
+    while(state.run())
+    {
+        std::string result = inif.encode();
+        bench::doNotOptimize(result);
+    }
+}
+BENCHMARK("corpus/encode", encodeCorpus);
+
+static void saveCorpus(bench::State &state)
+{
+    ini::IniFile inif;
+    inif.decode(corpus().text);
+    std::atexit(removeCorpusFiles);
+    state.setBytesPerIteration(corpus().text.size());
+    while(state.run())
+        inif.save(corpusSaveFileName);
+}
+BENCHMARK("corpus/save", saveCorpus);
+
+static std::string toLower(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), [](const char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    });
+    return str;
+}
+
+/** Looks up the sampled sections of the corpus, one per iteration. */
+template<typename File>
+static void lookupSections(bench::State &state, const bool lowerCase)
+{
+    File inif;
+    inif.decode(corpus().text);
+    std::vector<std::string> names;
+    for(const auto &sample : corpus().samples)
+        names.push_back(lowerCase ? toLower(sample.first) : sample.first);
+
+    std::size_t i = 0;
+    while(state.run())
+    {
+        bench::doNotOptimize(inif.get(names[i]));
+        i = i + 1 == names.size() ? 0 : i + 1;
+    }
+}
+
+/** Looks up the sampled fields of the corpus, one per iteration. */
+template<typename File>
+static void lookupFields(bench::State &state, const bool lowerCase)
+{
+    File inif;
+    inif.decode(corpus().text);
+    std::vector<std::pair<std::string, std::string>> names;
+    for(const auto &sample : corpus().samples)
+    {
+        names.emplace_back(lowerCase ? toLower(sample.first) : sample.first,
+            lowerCase ? toLower(sample.second) : sample.second);
+    }
+
+    std::size_t i = 0;
+    while(state.run())
+    {
+        bench::doNotOptimize(inif.get(names[i].first, names[i].second));
+        i = i + 1 == names.size() ? 0 : i + 1;
+    }
+}
+
+static void lookupSection(bench::State &state)
+{
+    lookupSections<ini::IniFile>(state, false);
+}
+BENCHMARK("corpus/lookup/section", lookupSection);
+
+static void lookupSectionInsensitive(bench::State &state)
+{
+    lookupSections<ini::IniFileCaseInsensitive>(state, true);
+}
+BENCHMARK("corpus/lookup/section/insensitive", lookupSectionInsensitive);
+
+static void lookupField(bench::State &state)
+{
+    lookupFields<ini::IniFile>(state, false);
+}
+BENCHMARK("corpus/lookup/field", lookupField);
+
+static void lookupFieldInsensitive(bench::State &state)
+{
+    lookupFields<ini::IniFileCaseInsensitive>(state, true);
+}
+BENCHMARK("corpus/lookup/field/insensitive", lookupFieldInsensitive);
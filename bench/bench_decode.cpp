@@ -0,0 +1,306 @@
+/*
+ * bench_decode.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <inicpp.h>
+#include <sstream>
+#include <thread>
+
+/** Creates an ini document with the given number of sections and fields. */
+static std::string makeIniContent(const std::size_t sections, const std::size_t fields)
+{
+    std::stringstream ss;
+    for(std::size_t i = 0; i < sections; ++i)
+    {
+        ss << "[section" << i << "]\n";
+        ss << "# some comment about section " << i << '\n';
+        for(std::size_t j = 0; j < fields; ++j)
+            ss << "key" << j << " = value number " << j << " of section " << i << " ; trailing comment\n";
+        ss << '\n';
+    }
+    return ss.str();
+}
+
+static const std::string &content()
+{
+    static const std::string result = makeIniContent(100, 100);
+    return result;
+}
+
+static void decodeIstream(bench::State &state)
+{
+    ini::IniFile inif;
+    state.setBytesPerIteration(content().size());
+    while(state.run())
+    {
+        std::istringstream is(content());
+        inif.decode(is);
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("decode/istream", decodeIstream);
+
+static void decodeString(bench::State &state)
+{
+    ini::IniFile inif;
+    state.setBytesPerIteration(content().size());
+    while(state.run())
+    {
+        inif.decode(content());
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("decode/string", decodeString);
+
+static void decodeBuffer(bench::State &state)
+{
+    ini::IniFile inif;
+    const std::string &data = content();
+    state.setBytesPerIteration(data.size());
+    while(state.run())
+    {
+        inif.decode(data.data(), data.size());
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("decode/buffer", decodeBuffer);
+
+/** Creates an ini document whose values contain many escaped comment
+  * prefixes. */
+static std::string makeEscapedContent(const std::size_t fields)
+{
+    std::stringstream ss;
+    ss << "[section]\n";
+    for(std::size_t i = 0; i < fields; ++i)
+    {
+        ss << "key" << i << " = ";
+        for(std::size_t j = 0; j < 8; ++j)
+            ss << "a\\#b\\;c\\REM";
+        ss << " REM trailing comment\n";
+    }
+    return ss.str();
+}
+
+static void decodeEscaped(bench::State &state)
+{
+    ini::IniFile inif('=', {"#", ";", "REM"});
+    const std::string data = makeEscapedContent(10000);
+    state.setBytesPerIteration(data.size());
+    while(state.run())
+    {
+        inif.decode(data.data(), data.size());
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("decode/escaped", decodeEscaped);
+
+/** Creates a section with a single multi-line value with the given number
+  * of continuation lines, like a certificate bundle. */
+static std::string makeMultiLineContent(const std::size_t lines)
+{
+    std::stringstream ss;
+    ss << "[certificates]\nbundle = -----BEGIN CERTIFICATE-----\n";
+    for(std::size_t i = 0; i < lines; ++i)
+        ss << "    MIIDdzCCAl+gAwIBAgIEAgAAuTANBgkqhkiG9w0BAQUFADBaMQswCQYDVQQGEwJJ" << i % 10 << '\n';
+    ss << "    -----END CERTIFICATE-----\n";
+    return ss.str();
+}
+
+static void decodeMultiLine(bench::State &state)
+{
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    const std::string data = makeMultiLineContent(10000);
+    state.setBytesPerIteration(data.size());
+    while(state.run())
+    {
+        inif.decode(data.data(), data.size());
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("decode/multiline/10k", decodeMultiLine);
+
+/** Counts the fields of a document without storing them. */
+struct CountingHandler : public ini::IniHandler
+{
+    std::size_t fields = 0;
+
+    bool onField(const ini::StringView, const ini::StringView, const int)
+    {
+        ++fields;
+        return true;
+    }
+};
+
+static void parseEvents(bench::State &state)
+{
+    ini::IniParser parser;
+    const std::string &data = content();
+    state.setBytesPerIteration(data.size());
+    while(state.run())
+    {
+        CountingHandler handler;
+        parser.parse(data, handler);
+        bench::doNotOptimize(handler.fields);
+    }
+}
+BENCHMARK("parse/events", parseEvents);
+
+static void parseIstream(bench::State &state)
+{
+    ini::IniParser parser;
+    state.setBytesPerIteration(content().size());
+    while(state.run())
+    {
+        std::istringstream is(content());
+        CountingHandler handler;
+        parser.parse(is, handler);
+        bench::doNotOptimize(handler.fields);
+    }
+}
+BENCHMARK("parse/istream", parseIstream);
+
+/** Looks up a single field and stops the parser once it was found. */
+struct FindHandler : public ini::IniHandler
+{
+    bool inSection = false;
+    std::string value;
+
+    bool onSection(const ini::StringView name, const int)
+    {
+        inSection = std::string(name.data(), name.size()) == "section10";
+        return true;
+    }
+
+    bool onField(const ini::StringView name, const ini::StringView val, const int)
+    {
+        if(!inSection || std::string(name.data(), name.size()) != "key5")
+            return true;
+        value.assign(val.data(), val.size());
+        return false;
+    }
+};
+
+static void parseFindField(bench::State &state)
+{
+    ini::IniParser parser;
+    const std::string &data = content();
+    while(state.run())
+    {
+        FindHandler handler;
+        parser.parse(data, handler);
+        bench::doNotOptimize(handler.value);
+    }
+}
+BENCHMARK("parse/find-field", parseFindField);
+
+#ifdef INICPP_HAS_THREADS
+static const std::string &largeContent()
+{
+    static const std::string result = makeIniContent(2000, 100);
+    return result;
+}
+
+static void decodeParallel(bench::State &state, const std::size_t threads)
+{
+    ini::IniFile inif;
+    inif.setThreadPool(std::make_shared<ini::ThreadPool>(threads));
+    const std::string &data = largeContent();
+    state.setBytesPerIteration(data.size());
+    while(state.run())
+    {
+        inif.decode(data.data(), data.size());
+        bench::doNotOptimize(inif);
+    }
+}
+
+static void decodeParallel1(bench::State &state)
+{
+    decodeParallel(state, 1);
+}
+BENCHMARK("decode/parallel/1", decodeParallel1);
+
+static void decodeParallel4(bench::State &state)
+{
+    decodeParallel(state, 4);
+}
+BENCHMARK("decode/parallel/4", decodeParallel4);
+
+static void decodeParallelAll(bench::State &state)
+{
+    decodeParallel(state, std::thread::hardware_concurrency());
+}
+BENCHMARK("decode/parallel/all", decodeParallelAll);
+#endif
+
+/** Typical service configuration which is filled from an ini file. */
+struct ServiceConfig
+{
+    std::string host;
+    int port;
+    double timeout;
+    bool verbose;
+    std::string dataDir;
+    std::string logFile;
+    int logLevel;
+    unsigned int threads;
+};
+
+static const std::string &serviceContent()
+{
+    static const std::string result =
+        "[Server]\nhost = example.com\nport = 8080\ntimeout = 2.5\nverbose = false\n\n"
+        "[Storage]\ndata_dir = /var/lib/service\nlog_file = /var/log/service.log\nlog_level = 3\nthreads = 8\n";
+    return result;
+}
+
+static void bindDecodeThenCopy(bench::State &state)
+{
+    state.setBytesPerIteration(serviceContent().size());
+    ServiceConfig config;
+    while(state.run())
+    {
+        ini::IniFile inif;
+        inif.decode(serviceContent());
+        ini::IniSection &server = inif["Server"];
+        ini::IniSection &storage = inif["Storage"];
+        config.host = server["host"].as<std::string>();
+        config.port = server["port"].as<int>();
+        config.timeout = server["timeout"].as<double>();
+        config.verbose = server["verbose"].as<bool>();
+        config.dataDir = storage["data_dir"].as<std::string>();
+        config.logFile = storage["log_file"].as<std::string>();
+        config.logLevel = storage["log_level"].as<int>();
+        config.threads = storage["threads"].as<unsigned int>();
+        bench::doNotOptimize(config);
+    }
+}
+BENCHMARK("bind/decode-then-copy", bindDecodeThenCopy);
+
+static void bindSchema(bench::State &state)
+{
+    ini::IniSchema<ServiceConfig> schema;
+    schema.required("Server", "host", &ServiceConfig::host)
+        .required("Server", "port", &ServiceConfig::port)
+        .required("Server", "timeout", &ServiceConfig::timeout)
+        .required("Server", "verbose", &ServiceConfig::verbose)
+        .required("Storage", "data_dir", &ServiceConfig::dataDir)
+        .required("Storage", "log_file", &ServiceConfig::logFile)
+        .required("Storage", "log_level", &ServiceConfig::logLevel)
+        .required("Storage", "threads", &ServiceConfig::threads);
+
+    state.setBytesPerIteration(serviceContent().size());
+    ServiceConfig config;
+    while(state.run())
+    {
+        ini::IniBindResult result = schema.decode(serviceContent(), config);
+        bench::doNotOptimize(result);
+        bench::doNotOptimize(config);
+    }
+}
+BENCHMARK("bind/schema", bindSchema);
@@ -0,0 +1,54 @@
+/*
+ * bench_encode.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <inicpp.h>
+#include <sstream>
+
+/** Creates an ini file with the given number of sections and fields. If
+  * escaped is set the values contain comment prefixes. */
+static ini::IniFile makeIniFile(const std::size_t sections, const std::size_t fields, const bool escaped)
+{
+    ini::IniFile inif;
+    for(std::size_t i = 0; i < sections; ++i)
+    {
+        ini::IniSection &sec = inif["section" + std::to_string(i)];
+        for(std::size_t j = 0; j < fields; ++j)
+        {
+            std::string value = "value number " + std::to_string(j);
+            if(escaped)
+                value += " # not a comment ; neither is this";
+            sec["key" + std::to_string(j)] = value;
+        }
+    }
+    return inif;
+}
+
+static void encodeFile(bench::State &state, const bool escaped)
+{
+    const ini::IniFile inif = makeIniFile(100, 100, escaped);
+    state.setBytesPerIteration(inif.encode().size());
+    while(state.run())
+    {
+        std::ostringstream os;
+        inif.encode(os);
+        bench::doNotOptimize(os);
+    }
+}
+
+static void encodePlain(bench::State &state)
+{
+    encodeFile(state, false);
+}
+BENCHMARK("encode/plain", encodePlain);
+
+static void encodeEscaped(bench::State &state)
+{
+    encodeFile(state, true);
+}
+BENCHMARK("encode/escaped", encodeEscaped);
@@ -0,0 +1,223 @@
+/*
+ * bench_load.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <inicpp.h>
+
+static const char *const benchFileName = "inicpp_bench_load.ini";
+static const char *const benchBinaryFileName = "inicpp_bench_load.inib";
+
+static void removeFile()
+{
+    std::remove(benchFileName);
+    std::remove(benchBinaryFileName);
+}
+
+/** Writes an ini file of roughly 16 MB to disk and returns its path and size. */
+static const std::string &fileName(std::size_t *size = nullptr)
+{
+    static std::size_t fileSize = 0;
+    static const std::string result = []() {
+        const std::string name = benchFileName;
+        std::atexit(removeFile);
+        std::ofstream os(name.c_str());
+        for(std::size_t i = 0; i < 2000; ++i)
+        {
+            os << "[section" << i << "]\n";
+            for(std::size_t j = 0; j < 100; ++j)
+                os << "key" << j << " = value number " << j << " of section " << i << " ; trailing comment\n";
+            os << '\n';
+        }
+        fileSize = static_cast<std::size_t>(os.tellp());
+        return name;
+    }();
+
+    if(size != nullptr)
+        *size = fileSize;
+    return result;
+}
+
+static void load(bench::State &state, const ini::LoadMode mode)
+{
+    std::size_t size;
+    const std::string &name = fileName(&size);
+    state.setBytesPerIteration(size);
+
+    ini::IniFile inif;
+    inif.setLoadMode(mode);
+    while(state.run())
+    {
+        inif.load(name);
+        bench::doNotOptimize(inif);
+    }
+}
+
+static void loadStream(bench::State &state)
+{
+    load(state, ini::LoadMode::Stream);
+}
+BENCHMARK("load/stream", loadStream);
+
+static void loadMapped(bench::State &state)
+{
+    load(state, ini::LoadMode::Mapped);
+}
+BENCHMARK("load/mapped", loadMapped);
+
+static void loadMappedPopulate(bench::State &state)
+{
+    load(state, ini::LoadMode::MappedPopulate);
+}
+BENCHMARK("load/mapped_populate", loadMappedPopulate);
+
+static void readFile(bench::State &state, const ini::LoadMode mode)
+{
+    std::size_t size;
+    const std::string &name = fileName(&size);
+    state.setBytesPerIteration(size);
+
+    ini::FileBuffer buffer;
+    while(state.run())
+    {
+        buffer.open(name, mode);
+        bench::doNotOptimize(buffer.data());
+    }
+}
+
+static void readStream(bench::State &state)
+{
+    readFile(state, ini::LoadMode::Stream);
+}
+BENCHMARK("read/stream", readStream);
+
+static void readMapped(bench::State &state)
+{
+    readFile(state, ini::LoadMode::Mapped);
+}
+BENCHMARK("read/mapped", readMapped);
+
+static void loadLazyIndex(bench::State &state)
+{
+    std::size_t size;
+    const std::string &name = fileName(&size);
+    state.setBytesPerIteration(size);
+
+    ini::IniFile inif;
+    inif.setLazyLoad(true);
+    while(state.run())
+    {
+        inif.load(name);
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("load/lazy/index", loadLazyIndex);
+
+/** Loads the file and reads a field of 5 out of 2000 sections. */
+static void loadSparse(bench::State &state, const bool lazy)
+{
+    const std::string &name = fileName();
+    const char *const sections[] = {"section7", "section500", "section1000", "section1500", "section1999"};
+
+    ini::IniFile inif;
+    inif.setLazyLoad(lazy);
+    while(state.run())
+    {
+        inif.load(name);
+        int sum = 0;
+        for(const char *section : sections)
+            sum += inif[section]["key42"].as<std::string>().size();
+        bench::doNotOptimize(sum);
+    }
+}
+
+static void loadSparseEager(bench::State &state)
+{
+    loadSparse(state, false);
+}
+BENCHMARK("load/sparse/eager", loadSparseEager);
+
+static void loadSparseLazy(bench::State &state)
+{
+    loadSparse(state, true);
+}
+BENCHMARK("load/sparse/lazy", loadSparseLazy);
+
+static void reloadUnchanged(bench::State &state)
+{
+    std::size_t size;
+    const std::string &name = fileName(&size);
+    state.setBytesPerIteration(size);
+
+    ini::IniReloader<ini::IniFile> reloader(name);
+    while(state.run())
+    {
+        ini::IniDiff changes = reloader.reload();
+        bench::doNotOptimize(changes);
+    }
+}
+BENCHMARK("reload/unchanged", reloadUnchanged);
+
+/** Converts the text file to a binary ini file once and returns its path. */
+static const std::string &binaryFileName()
+{
+    static const std::string result = []() {
+        ini::IniFile inif;
+        inif.load(fileName());
+        inif.saveBinary(benchBinaryFileName);
+        return std::string(benchBinaryFileName);
+    }();
+    return result;
+}
+
+static const char *const startupSections[] = {"section7", "section500", "section1000", "section1500", "section1999"};
+
+/** Loads the text file and reads a field of 5 sections, like a process at
+  * startup. */
+static void startupText(bench::State &state)
+{
+    const std::string &name = fileName();
+    while(state.run())
+    {
+        ini::IniFile inif;
+        inif.load(name);
+        int sum = 0;
+        for(const char *section : startupSections)
+            sum += inif.getOr(section, "key42", "").size();
+        bench::doNotOptimize(sum);
+    }
+}
+BENCHMARK("startup/text", startupText);
+
+/** Opens the binary file and reads the same fields as startupText. */
+static void startupBinary(bench::State &state, const bool verify)
+{
+    const std::string &name = binaryFileName();
+    while(state.run())
+    {
+        ini::IniBinaryFile file(name, verify);
+        int sum = 0;
+        for(const char *section : startupSections)
+            sum += file.getOr(section, "key42", "").size();
+        bench::doNotOptimize(sum);
+    }
+}
+
+static void startupBinaryVerified(bench::State &state)
+{
+    startupBinary(state, true);
+}
+BENCHMARK("startup/binary/verified", startupBinaryVerified);
+
+static void startupBinaryUnverified(bench::State &state)
+{
+    startupBinary(state, false);
+}
+BENCHMARK("startup/binary/unverified", startupBinaryUnverified);
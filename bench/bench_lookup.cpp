@@ -0,0 +1,97 @@
+/*
+ * bench_lookup.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <inicpp.h>
+
+static const std::size_t sectionCount = 64;
+static const std::size_t fieldCount = 64;
+
+/** Returns the names of the sections and fields which are looked up. */
+static const std::vector<std::pair<std::string, std::string>> &lookupKeys()
+{
+    static const std::vector<std::pair<std::string, std::string>> result = []() {
+        std::vector<std::pair<std::string, std::string>> keys;
+        // visit the keys in a scattered order, so lookups do not simply
+        // follow the memory layout
+        for(std::size_t i = 0; i < sectionCount * fieldCount; ++i)
+        {
+            const std::size_t idx = (i * 7919) % (sectionCount * fieldCount);
+            keys.emplace_back("section_" + std::to_string(idx / fieldCount),
+                "some_field_name_" + std::to_string(idx % fieldCount));
+        }
+        return keys;
+    }();
+    return result;
+}
+
+template<typename IniFileT>
+static void fillFile(IniFileT &inif)
+{
+    for(std::size_t i = 0; i < sectionCount; ++i)
+    {
+        for(std::size_t j = 0; j < fieldCount; ++j)
+            inif["section_" + std::to_string(i)]["some_field_name_" + std::to_string(j)] = j;
+    }
+}
+
+template<typename IniFileT>
+static void lookup(bench::State &state)
+{
+    IniFileT inif;
+    fillFile(inif);
+
+    const auto &keys = lookupKeys();
+    std::size_t idx = 0;
+    while(state.run())
+    {
+        const auto &key = keys[idx];
+        bench::doNotOptimize(inif[key.first][key.second]);
+        idx = idx + 1 == keys.size() ? 0 : idx + 1;
+    }
+}
+
+template<typename IniFileT>
+static void lookupLiteral(bench::State &state)
+{
+    IniFileT inif;
+    fillFile(inif);
+
+    while(state.run())
+        bench::doNotOptimize(inif["section_42"]["some_field_name_42"]);
+}
+
+using IniFileMap = ini::IniFileBase<std::less<std::string>, ini::MapStorage>;
+using IniFileFlat = ini::IniFileBase<std::less<std::string>, ini::FlatStorage>;
+using IniFileHash = ini::IniFileBase<std::less<std::string>, ini::HashStorage>;
+
+BENCHMARK("lookup/map", lookup<IniFileMap>);
+BENCHMARK("lookup/flat", lookup<IniFileFlat>);
+BENCHMARK("lookup/hash", lookup<IniFileHash>);
+BENCHMARK("lookup/literal/map", lookupLiteral<IniFileMap>);
+BENCHMARK("lookup/literal/flat", lookupLiteral<IniFileFlat>);
+BENCHMARK("lookup/literal/hash", lookupLiteral<IniFileHash>);
+
+using IniFileInsensitiveMap = ini::IniFileBase<ini::StringInsensitiveLess, ini::MapStorage>;
+using IniFileInsensitiveFlat = ini::IniFileBase<ini::StringInsensitiveLess, ini::FlatStorage>;
+using IniFileInsensitiveHash = ini::IniFileBase<ini::StringInsensitiveLess, ini::HashStorage>;
+
+BENCHMARK("lookup/insensitive/map", lookup<IniFileInsensitiveMap>);
+BENCHMARK("lookup/insensitive/flat", lookup<IniFileInsensitiveFlat>);
+BENCHMARK("lookup/insensitive/hash", lookup<IniFileInsensitiveHash>);
+
+static void compareInsensitive(bench::State &state)
+{
+    const std::string lhs = "Some_Field_Name_With_A_Long_Prefix_42";
+    const std::string rhs = "some_field_name_with_a_long_prefix_43";
+    ini::StringInsensitiveLess comp;
+    state.setBytesPerIteration(lhs.size() + rhs.size());
+    while(state.run())
+        bench::doNotOptimize(comp(lhs, rhs));
+}
+BENCHMARK("compare/insensitive", compareInsensitive);
@@ -0,0 +1,84 @@
+/*
+ * bench_memory.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <inicpp.h>
+#include <memory>
+#include <sstream>
+
+/** Creates an ini document whose names and values do not fit into the small
+  * string buffer, so every string has to be allocated. */
+static const std::string &content()
+{
+    static const std::string result = []() {
+        std::stringstream ss;
+        for(std::size_t i = 0; i < 100; ++i)
+        {
+            ss << "[a section with a long name " << i << "]\n";
+            for(std::size_t j = 0; j < 100; ++j)
+                ss << "a field with a long name " << j << " = a value which does not fit into a small string " << j << '\n';
+        }
+        return ss.str();
+    }();
+    return result;
+}
+
+static void decodeHeap(bench::State &state)
+{
+    state.setBytesPerIteration(content().size());
+    while(state.run())
+    {
+        ini::IniFile inif;
+        inif.decode(content());
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("memory/decode+destroy/heap", decodeHeap);
+
+static void destroyHeap(bench::State &state)
+{
+    while(state.run())
+    {
+        state.pause();
+        std::unique_ptr<ini::IniFile> inif(new ini::IniFile());
+        inif->decode(content());
+        state.resume();
+        inif.reset();
+    }
+}
+BENCHMARK("memory/destroy/heap", destroyHeap);
+
+#ifdef INICPP_HAS_PMR
+static void decodeArena(bench::State &state)
+{
+    state.setBytesPerIteration(content().size());
+    while(state.run())
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        ini::pmr::IniFile inif(&arena);
+        inif.decode(content());
+        bench::doNotOptimize(inif);
+    }
+}
+BENCHMARK("memory/decode+destroy/arena", decodeArena);
+
+static void destroyArena(bench::State &state)
+{
+    while(state.run())
+    {
+        state.pause();
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> arena(new std::pmr::monotonic_buffer_resource());
+        std::unique_ptr<ini::pmr::IniFile> inif(new ini::pmr::IniFile(arena.get()));
+        inif->decode(content());
+        state.resume();
+        inif.reset();
+        arena.reset();
+    }
+}
+BENCHMARK("memory/destroy/arena", destroyArena);
+#endif
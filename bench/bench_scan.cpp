@@ -0,0 +1,106 @@
+/*
+ * bench_scan.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <inicpp.h>
+#include <sstream>
+
+/** Creates an ini document with long values and comments, so most bytes
+  * carry no structure. */
+static const std::string &content()
+{
+    static const std::string result = []() {
+        std::stringstream ss;
+        for(std::size_t i = 0; i < 200; ++i)
+        {
+            ss << "[section" << i << "]\n";
+            ss << "# this section contains fields with long values, which is typical for paths and urls\n";
+            for(std::size_t j = 0; j < 50; ++j)
+                ss << "key" << j << " = /usr/share/some/rather/long/path/to/a/resource/file_" << j
+                   << ".dat ; trailing comment\n";
+            ss << '\n';
+        }
+        return ss.str();
+    }();
+    return result;
+}
+
+static void scan(bench::State &state, const ini::ScanKernel kernel)
+{
+    ini::ByteScanner scanner("\n]=\\#;");
+    scanner.setKernel(kernel);
+    const std::string &data = content();
+    state.setBytesPerIteration(data.size());
+
+    while(state.run())
+    {
+        const char *pos = data.data();
+        const char *end = data.data() + data.size();
+        std::size_t cnt = 0;
+        while(pos != end)
+        {
+            pos = scanner.find(pos, end);
+            if(pos != end)
+            {
+                ++cnt;
+                ++pos;
+            }
+        }
+        bench::doNotOptimize(cnt);
+    }
+}
+
+static void decode(bench::State &state, const ini::ScanKernel kernel)
+{
+    ini::IniFile inif;
+    inif.setScanKernel(kernel);
+    const std::string &data = content();
+    state.setBytesPerIteration(data.size());
+
+    while(state.run())
+    {
+        inif.decode(data);
+        bench::doNotOptimize(inif);
+    }
+}
+
+static void scanScalar(bench::State &state)
+{
+    scan(state, ini::ScanKernel::Scalar);
+}
+BENCHMARK("scan/scalar", scanScalar);
+
+static void scanSSE2(bench::State &state)
+{
+    scan(state, ini::ScanKernel::SSE2);
+}
+BENCHMARK("scan/sse2", scanSSE2);
+
+static void scanAVX2(bench::State &state)
+{
+    scan(state, ini::ScanKernel::AVX2);
+}
+BENCHMARK("scan/avx2", scanAVX2);
+
+static void decodeScalar(bench::State &state)
+{
+    decode(state, ini::ScanKernel::Scalar);
+}
+BENCHMARK("decode/scan/scalar", decodeScalar);
+
+static void decodeSSE2(bench::State &state)
+{
+    decode(state, ini::ScanKernel::SSE2);
+}
+BENCHMARK("decode/scan/sse2", decodeSSE2);
+
+static void decodeAVX2(bench::State &state)
+{
+    decode(state, ini::ScanKernel::AVX2);
+}
+BENCHMARK("decode/scan/avx2", decodeAVX2);
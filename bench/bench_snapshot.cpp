@@ -0,0 +1,156 @@
+/*
+ * bench_snapshot.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include <inicpp.h>
+
+#ifdef INICPP_HAS_THREADS
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+static const std::size_t readsPerThread = 20000;
+static const std::size_t sectionCount = 32;
+static const std::size_t fieldCount = 32;
+
+static ini::IniFile makeFile(const int version)
+{
+    ini::IniFile inif;
+    for(std::size_t i = 0; i < sectionCount; ++i)
+    {
+        for(std::size_t j = 0; j < fieldCount; ++j)
+            inif["section_" + std::to_string(i)]["field_" + std::to_string(j)] = version;
+    }
+    return inif;
+}
+
+static const std::vector<std::pair<std::string, std::string>> &readKeys()
+{
+    static const std::vector<std::pair<std::string, std::string>> result = []() {
+        std::vector<std::pair<std::string, std::string>> keys;
+        for(std::size_t i = 0; i < sectionCount * fieldCount; ++i)
+        {
+            const std::size_t idx = (i * 7919) % (sectionCount * fieldCount);
+            keys.emplace_back("section_" + std::to_string(idx / fieldCount), "field_" + std::to_string(idx % fieldCount));
+        }
+        return keys;
+    }();
+    return result;
+}
+
+/** Runs the given read function on several threads while another thread
+  * keeps replacing the configuration. */
+template<typename Read, typename Write>
+static void readConcurrently(bench::State &state, const std::size_t threads, Read read, Write write)
+{
+    state.setBytesPerIteration(0);
+    while(state.run())
+    {
+        std::atomic<bool> done(false);
+        std::thread writer([&]() {
+            int version = 0;
+            while(!done.load())
+            {
+                write(++version);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        std::vector<std::thread> readers;
+        for(std::size_t t = 0; t < threads; ++t)
+        {
+            readers.emplace_back([&, t]() {
+                read(t);
+            });
+        }
+        for(std::thread &reader : readers)
+            reader.join();
+        done = true;
+        writer.join();
+    }
+}
+
+static void readMutex(bench::State &state, const std::size_t threads)
+{
+    std::mutex mutex;
+    ini::IniFile inif = makeFile(0);
+    const auto &keys = readKeys();
+    readConcurrently(state,
+        threads,
+        [&](const std::size_t t) {
+            int sum = 0;
+            for(std::size_t i = 0; i < readsPerThread; ++i)
+            {
+                const auto &key = keys[(i + t * 101) % keys.size()];
+                std::lock_guard<std::mutex> lock(mutex);
+                sum += inif.at(key.first).at(key.second).as<int>();
+            }
+            bench::doNotOptimize(sum);
+        },
+        [&](const int version) {
+            ini::IniFile next = makeFile(version);
+            std::lock_guard<std::mutex> lock(mutex);
+            inif = std::move(next);
+        });
+}
+
+static void readSnapshot(bench::State &state, const std::size_t threads)
+{
+    ini::IniPublisher<ini::IniFile> publisher(makeFile(0));
+    const auto &keys = readKeys();
+    readConcurrently(state,
+        threads,
+        [&](const std::size_t t) {
+            ini::IniPublisher<ini::IniFile>::Reader reader = publisher.reader();
+            int sum = 0;
+            for(std::size_t i = 0; i < readsPerThread; ++i)
+            {
+                const auto &key = keys[(i + t * 101) % keys.size()];
+                sum += reader->at(key.first).at(key.second).as<int>();
+            }
+            bench::doNotOptimize(sum);
+        },
+        [&](const int version) { publisher.publish(makeFile(version)); });
+}
+
+static void readMutex1(bench::State &state)
+{
+    readMutex(state, 1);
+}
+BENCHMARK("snapshot/read/mutex/1", readMutex1);
+
+static void readMutex4(bench::State &state)
+{
+    readMutex(state, 4);
+}
+BENCHMARK("snapshot/read/mutex/4", readMutex4);
+
+static void readMutex16(bench::State &state)
+{
+    readMutex(state, 16);
+}
+BENCHMARK("snapshot/read/mutex/16", readMutex16);
+
+static void readSnapshot1(bench::State &state)
+{
+    readSnapshot(state, 1);
+}
+BENCHMARK("snapshot/read/publisher/1", readSnapshot1);
+
+static void readSnapshot4(bench::State &state)
+{
+    readSnapshot(state, 4);
+}
+BENCHMARK("snapshot/read/publisher/4", readSnapshot4);
+
+static void readSnapshot16(bench::State &state)
+{
+    readSnapshot(state, 16);
+}
+BENCHMARK("snapshot/read/publisher/16", readSnapshot16);
+#endif
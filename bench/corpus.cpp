@@ -0,0 +1,194 @@
+/*
+ * corpus.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "corpus.h"
+#include <cstdlib>
+
+namespace bench
+{
+    /** SplitMix64 generator. The standard distributions are implementation
+      * defined, so all numbers are derived from the raw output. */
+    class Random
+    {
+    private:
+        std::uint64_t state_;
+
+    public:
+        explicit Random(const std::uint64_t seed) : state_(seed)
+        {}
+
+        std::uint64_t next()
+        {
+            std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /** Returns a number in [0, bound). */
+        std::size_t below(const std::size_t bound)
+        {
+            return bound == 0 ? 0 : static_cast<std::size_t>(next() % bound);
+        }
+
+        /** Returns true with the given probability. */
+        bool chance(const double probability)
+        {
+            return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+        }
+    };
+
+    static const char *const syllables[] = {"net", "cache", "max", "log", "path", "time", "user", "port", "host",
+        "queue", "size", "retry", "buffer", "level", "mode", "limit", "pool", "shard", "disk", "key"};
+    static const std::size_t syllableCount = sizeof(syllables) / sizeof(syllables[0]);
+
+    static void appendName(std::string &str, Random &rng, const std::size_t number)
+    {
+        const std::size_t count = 1 + rng.below(3);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const char *syllable = syllables[rng.below(syllableCount)];
+            // capitalize all but the first syllable
+            str += i == 0 ? syllable[0] : static_cast<char>(syllable[0] - 'a' + 'A');
+            str += syllable + 1;
+        }
+        str += '_';
+        str += std::to_string(number);
+    }
+
+    static void appendText(std::string &str, Random &rng, const std::size_t size)
+    {
+        const std::size_t start = str.size();
+        while(str.size() - start < size)
+        {
+            if(str.size() != start)
+                str += ' ';
+            str += syllables[rng.below(syllableCount)];
+            // exercise unescaping now and then
+            if(rng.chance(0.02))
+                str += " \\# tag";
+        }
+    }
+
+    static void appendValue(std::string &str, Random &rng, const std::size_t valueSize)
+    {
+        switch(rng.below(4))
+        {
+        case 0:
+            str += std::to_string(static_cast<long>(rng.below(2000000)) - 1000000);
+            break;
+        case 1:
+        {
+            // formatted by hand, so the decimal point does not depend on the
+            // locale
+            const std::size_t value = rng.below(1000000);
+            const std::string fraction = std::to_string(1000 + value % 1000);
+            str += std::to_string(value / 1000);
+            str += '.';
+            str += fraction.substr(1);
+            break;
+        }
+        case 2:
+            str += rng.chance(0.5) ? "true" : "false";
+            break;
+        default:
+            appendText(str, rng, valueSize / 2 + rng.below(valueSize + 1));
+            break;
+        }
+    }
+
+    Corpus generateCorpus(const CorpusOptions &options)
+    {
+        const std::size_t maxSamples = 1024;
+        Corpus result;
+        Random rng(options.seed);
+        // samples are drawn independently, so they do not change the text
+        Random sampleRng(options.seed ^ 0x5DEECE66DULL);
+        std::string &text = result.text;
+        text.reserve(options.bytes + options.bytes / 8 + 1024);
+
+        std::string section;
+        std::string name;
+        while(text.size() < options.bytes)
+        {
+            section.clear();
+            appendName(section, rng, result.sections);
+            text += '[';
+            text += section;
+            text += "]\n";
+            ++result.sections;
+
+            for(std::size_t i = 0; i < options.fieldsPerSection; ++i)
+            {
+                if(rng.chance(options.commentDensity / 2))
+                {
+                    text += "# ";
+                    appendText(text, rng, 32);
+                    text += '\n';
+                }
+
+                name.clear();
+                appendName(name, rng, i);
+                text += name;
+                text += " = ";
+                appendValue(text, rng, options.valueSize);
+                while(rng.chance(options.multiLineDensity))
+                {
+                    text += "\n    ";
+                    appendText(text, rng, options.valueSize);
+                }
+                if(rng.chance(options.commentDensity / 2))
+                {
+                    text += " ; ";
+                    appendText(text, rng, 16);
+                }
+                text += '\n';
+                ++result.fields;
+
+                // reservoir sampling keeps an even spread of the names
+                if(result.samples.size() < maxSamples)
+                    result.samples.emplace_back(section, name);
+                else
+                {
+                    const std::size_t slot = sampleRng.below(result.fields);
+                    if(slot < maxSamples)
+                        result.samples[slot] = std::make_pair(section, name);
+                }
+            }
+            text += '\n';
+        }
+        return result;
+    }
+
+    CorpusOptions &corpusOptions()
+    {
+        static CorpusOptions options;
+        return options;
+    }
+
+    bool parseSize(const std::string &str, std::size_t &result)
+    {
+        char *end = nullptr;
+        const unsigned long long value = std::strtoull(str.c_str(), &end, 10);
+        if(end == str.c_str())
+            return false;
+
+        std::size_t factor = 1;
+        const std::string suffix(end);
+        if(suffix == "K" || suffix == "k")
+            factor = 1024;
+        else if(suffix == "M" || suffix == "m")
+            factor = 1024 * 1024;
+        else if(suffix == "G" || suffix == "g")
+            factor = 1024 * 1024 * 1024;
+        else if(!suffix.empty())
+            return false;
+        result = static_cast<std::size_t>(value) * factor;
+        return true;
+    }
+}
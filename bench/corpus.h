@@ -0,0 +1,65 @@
+/*
+ * corpus.h
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#ifndef INICPP_BENCH_CORPUS_H_
+#define INICPP_BENCH_CORPUS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+    /** Shape of a generated ini document. */
+    struct CorpusOptions
+    {
+        /** Size of the document in bytes, the last section may exceed it. */
+        std::size_t bytes = 1024 * 1024;
+        /** Number of fields in each section. */
+        std::size_t fieldsPerSection = 20;
+        /** Share of fields which are preceded by a comment line or followed
+          * by an inline comment. */
+        double commentDensity = 0.1;
+        /** Average number of characters of a value. */
+        std::size_t valueSize = 24;
+        /** Share of values which continue on indented lines. Such documents
+          * have to be decoded with multi-line values enabled. */
+        double multiLineDensity = 0.0;
+        /** Seed of the generator, equal options produce equal documents on
+          * all platforms. */
+        std::uint64_t seed = 42;
+    };
+
+    /** Generated ini document. */
+    struct Corpus
+    {
+        std::string text;
+        std::size_t sections = 0;
+        std::size_t fields = 0;
+        /** Section and field names spread evenly over the document, which
+          * can be used for lookups. */
+        std::vector<std::pair<std::string, std::string>> samples;
+    };
+
+    /** Generates an ini document with the given shape. Names mix upper and
+      * lower case letters, values are integers, floating point numbers,
+      * booleans and text, some of which contains escaped comment prefixes. */
+    Corpus generateCorpus(const CorpusOptions &options);
+
+    /** Returns the options of the corpus used by the benchmarks, which can
+      * be changed on the command line. */
+    CorpusOptions &corpusOptions();
+
+    /** Parses a number of bytes with an optional K, M or G suffix. Returns
+      * false if the string is not a valid size. */
+    bool parseSize(const std::string &str, std::size_t &result);
+}
+
+#endif
@@ -0,0 +1,250 @@
+/*
+ * main.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "bench.h"
+#include "corpus.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static std::atomic<std::size_t> allocations(0);
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if(ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace bench
+{
+    std::size_t allocationCount()
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    std::vector<Benchmark> &registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+}
+
+/** Result of a single benchmark. */
+struct Result
+{
+    std::string name;
+    std::size_t iterations;
+    double nsPerOp;
+    std::size_t bytesPerOp;
+    double mbPerSec;
+    double allocsPerOp;
+};
+
+static void printUsage(const char *program)
+{
+    std::fprintf(stderr,
+        "usage: %s [options] [filter]\n"
+        "  filter                 only run benchmarks whose name contains this string\n"
+        "  --json                 print the results as JSON\n"
+        "  --output=FILE          write the results to FILE instead of stdout\n"
+        "  --min-time=SECONDS     minimum measured time of each benchmark (default 0.5)\n"
+        "  --size=BYTES           size of the generated corpus, with K, M or G suffix (default 1M)\n"
+        "  --fields=N             fields per section of the corpus (default 20)\n"
+        "  --comments=SHARE       share of commented fields in the corpus (default 0.1)\n"
+        "  --value-size=N         average value size of the corpus (default 24)\n"
+        "  --multiline=SHARE      share of multi-line values in the multi-line corpus (default 0.2)\n"
+        "  --seed=N               seed of the corpus generator (default 42)\n",
+        program);
+}
+
+/** Returns the value of an option of the form --name=value or nullptr. */
+static const char *optionValue(const char *arg, const char *name)
+{
+    const std::size_t length = std::strlen(name);
+    if(std::strncmp(arg, name, length) != 0 || arg[length] != '=')
+        return nullptr;
+    return arg + length + 1;
+}
+
+static void writeJsonString(std::FILE *out, const std::string &str)
+{
+    std::fputc('"', out);
+    for(const char c : str)
+    {
+        if(c == '"' || c == '\\')
+            std::fputc('\\', out);
+        std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+static void writeJson(std::FILE *out, const std::vector<Result> &results, const double minTime)
+{
+    const bench::CorpusOptions &corpus = bench::corpusOptions();
+    std::fprintf(out, "{\n  \"context\": {\n");
+#if defined(__clang__)
+    std::fprintf(out, "    \"compiler\": \"clang %s\",\n", __clang_version__);
+#elif defined(__GNUC__)
+    std::fprintf(out, "    \"compiler\": \"gcc %s\",\n", __VERSION__);
+#elif defined(_MSC_VER)
+    std::fprintf(out, "    \"compiler\": \"msvc %d\",\n", _MSC_VER);
+#endif
+    std::fprintf(out, "    \"cplusplus\": %ld,\n", static_cast<long>(__cplusplus));
+    std::fprintf(out, "    \"min_time\": %g,\n", minTime);
+    std::fprintf(out,
+        "    \"corpus\": {\"bytes\": %zu, \"fields_per_section\": %zu, \"comment_density\": %g, "
+        "\"value_size\": %zu, \"multiline_density\": %g, \"seed\": %llu}\n",
+        corpus.bytes,
+        corpus.fieldsPerSection,
+        corpus.commentDensity,
+        corpus.valueSize,
+        corpus.multiLineDensity,
+        static_cast<unsigned long long>(corpus.seed));
+    std::fprintf(out, "  },\n  \"benchmarks\": [");
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &result = results[i];
+        std::fprintf(out, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+        writeJsonString(out, result.name);
+        std::fprintf(out, ", \"iterations\": %zu, \"ns_per_op\": %.1f, \"bytes_per_op\": %zu, ",
+            result.iterations,
+            result.nsPerOp,
+            result.bytesPerOp);
+        if(result.bytesPerOp > 0)
+            std::fprintf(out, "\"mb_per_s\": %.1f, ", result.mbPerSec);
+        else
+            std::fprintf(out, "\"mb_per_s\": null, ");
+        std::fprintf(out, "\"allocs_per_op\": %.2f}", result.allocsPerOp);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    // optional substring filter for the benchmark names
+    std::string filter;
+    bool json = false;
+    const char *output = nullptr;
+    double minTime = 0.5;
+    bench::CorpusOptions &corpus = bench::corpusOptions();
+    corpus.multiLineDensity = 0.2;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = nullptr;
+        bool valid = true;
+        if(std::strcmp(arg, "--json") == 0)
+            json = true;
+        else if((value = optionValue(arg, "--output")) != nullptr)
+            output = value;
+        else if((value = optionValue(arg, "--min-time")) != nullptr)
+            minTime = std::atof(value);
+        else if((value = optionValue(arg, "--size")) != nullptr)
+            valid = bench::parseSize(value, corpus.bytes);
+        else if((value = optionValue(arg, "--fields")) != nullptr)
+            corpus.fieldsPerSection = static_cast<std::size_t>(std::strtoull(value, nullptr, 10));
+        else if((value = optionValue(arg, "--comments")) != nullptr)
+            corpus.commentDensity = std::atof(value);
+        else if((value = optionValue(arg, "--value-size")) != nullptr)
+            corpus.valueSize = static_cast<std::size_t>(std::strtoull(value, nullptr, 10));
+        else if((value = optionValue(arg, "--multiline")) != nullptr)
+            corpus.multiLineDensity = std::atof(value);
+        else if((value = optionValue(arg, "--seed")) != nullptr)
+            corpus.seed = std::strtoull(value, nullptr, 10);
+        else if(arg[0] == '-')
+            valid = false;
+        else
+            filter = arg;
+
+        if(!valid || minTime <= 0 || corpus.fieldsPerSection == 0)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::FILE *out = stdout;
+    if(output != nullptr)
+    {
+        out = std::fopen(output, "w");
+        if(out == nullptr)
+        {
+            std::fprintf(stderr, "cannot open %s\n", output);
+            return 1;
+        }
+    }
+
+    if(!json)
+        std::fprintf(out, "%-48s %12s %14s %12s %12s\n", "benchmark", "iterations", "ns/op", "MB/s", "allocs/op");
+    std::vector<Result> results;
+    for(const bench::Benchmark &benchmark : bench::registry())
+    {
+        if(benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        bench::State state(minTime);
+        benchmark.function(state);
+
+        const double iterations = static_cast<double>(state.iterations());
+        Result result;
+        result.name = benchmark.name;
+        result.iterations = state.iterations();
+        result.nsPerOp = state.seconds() * 1e9 / iterations;
+        result.bytesPerOp = state.bytesPerIteration();
+        result.mbPerSec = static_cast<double>(state.bytesPerIteration()) * iterations / state.seconds() / 1e6;
+        result.allocsPerOp = static_cast<double>(state.allocations()) / iterations;
+        results.push_back(result);
+        if(json)
+            continue;
+
+        std::fprintf(out, "%-48s %12zu %14.1f ", result.name.c_str(), result.iterations, result.nsPerOp);
+        if(result.bytesPerOp > 0)
+            std::fprintf(out, "%12.1f", result.mbPerSec);
+        else
+            std::fprintf(out, "%12s", "-");
+        std::fprintf(out, " %12.2f\n", result.allocsPerOp);
+        std::fflush(out);
+    }
+
+    if(json)
+        writeJson(out, results, minTime);
+    if(out != stdout)
+        std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,57 @@
+# inicpp_embed.cmake
+#
+#     Author: Fabian Meyer
+# Created On: 18 Oct 2026
+#    License: MIT
+#
+# Script which writes a header embedding an ini file as ini::StaticIniFile.
+# Invoked by inicpp_embed_ini() with the variables INPUT, OUTPUT, NAME and
+# NAMESPACE.
+
+file(READ "${INPUT}" content)
+
+set(delimiter "inicpp")
+string(FIND "${content}" ")${delimiter}\"" found)
+if(NOT found EQUAL -1)
+    message(FATAL_ERROR "${INPUT} contains the raw string delimiter )${delimiter}\"")
+endif()
+
+# split the literal into pieces, which compilers concatenate, because some
+# limit the length of a single string literal
+set(literal "")
+string(LENGTH "${content}" length)
+set(pos 0)
+while(pos LESS length)
+    string(SUBSTRING "${content}" ${pos} 4096 piece)
+    string(APPEND literal "R\"${delimiter}(${piece})${delimiter}\"\n")
+    math(EXPR pos "${pos} + 4096")
+endwhile()
+if(literal STREQUAL "")
+    set(literal "\"\"")
+endif()
+
+if(NAMESPACE)
+    set(open_namespace "namespace ${NAMESPACE}\n{\n")
+    set(close_namespace "}\n")
+endif()
+
+file(WRITE "${OUTPUT}.tmp"
+"// generated by inicpp_embed_ini() from ${INPUT}, do not edit
+
+#pragma once
+
+#include <inicpp.h>
+
+#ifndef INICPP_HAS_CONSTEXPR_PARSE
+#   error \"embedded ini files require C++17\"
+#endif
+
+${open_namespace}inline constexpr char ${NAME}_text[] =
+${literal};
+
+inline constexpr ini::StaticIniFile<sizeof(${NAME}_text), ini::staticIniCapacity(${NAME}_text)> ${NAME}(${NAME}_text);
+${close_namespace}")
+
+# only touch the header if it changed, so dependent sources are not rebuilt
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${OUTPUT}.tmp" "${OUTPUT}")
+file(REMOVE "${OUTPUT}.tmp")
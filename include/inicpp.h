@@ -10,12 +10,25 @@
 #define INICPP_H_
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <istream>
+#include <functional>
+#include <limits>
 #include <map>
+#include <memory>
 #include <assert.h>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -23,6 +36,69 @@
 #   include <string_view>
 #endif
 
+#if defined(__has_include)
+#   if __has_include(<memory_resource>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#       include <memory_resource>
+#       ifdef __cpp_lib_memory_resource
+#           define INICPP_HAS_PMR
+#       endif
+#   endif
+#   if __has_include(<charconv>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#       define INICPP_HAS_CHARCONV
+#       include <charconv>
+#   endif
+#endif
+
+#if defined(INICPP_HAS_CHARCONV) && defined(__cpp_lib_to_chars)
+#   define INICPP_HAS_FLOAT_CHARCONV
+#endif
+
+#if defined(__cpp_lib_string_view) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#   define INICPP_HAS_CONSTEXPR_PARSE
+#   include <optional>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#   define INICPP_HAS_MMAP
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#if defined(__linux__) && !defined(INICPP_NO_INOTIFY)
+#   define INICPP_HAS_INOTIFY
+#   include <poll.h>
+#   include <sys/inotify.h>
+#endif
+
+#ifndef INICPP_NO_THREADS
+#   define INICPP_HAS_THREADS
+#   include <condition_variable>
+#   include <exception>
+#   include <mutex>
+#   include <thread>
+#endif
+
+#ifdef INICPP_ENABLE_STATS
+#   define INICPP_HAS_STATS
+#   include <chrono>
+#endif
+
+#ifndef INICPP_NO_SIMD
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define INICPP_HAS_SSE2
+#       include <emmintrin.h>
+#       if defined(_MSC_VER) && !defined(__clang__)
+#           include <intrin.h>
+#       endif
+#   endif
+#   if defined(INICPP_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#       define INICPP_HAS_AVX2
+#       include <immintrin.h>
+#   endif
+#endif
+
 namespace ini
 {
     /************************************************
@@ -60,729 +136,6795 @@ namespace ini
         str.erase(0, str.find_first_not_of(whitespaces()));
     }
 
-    /************************************************
-     * Conversion Functors
-     ************************************************/
-
-    inline bool strToLong(const std::string &value, long &result)
+#ifdef __cpp_lib_string_view
+    using StringView = std::string_view;
+#else
+    /** Non-owning reference to a range of characters.
+      * This is a minimal replacement for std::string_view on C++ standards
+      * which do not provide it. */
+    class StringView
     {
-        char *endptr;
-        // check if decimal
-        result = std::strtol(value.c_str(), &endptr, 10);
-        if(*endptr == '\0')
-            return true;
-        // check if octal
-        result = std::strtol(value.c_str(), &endptr, 8);
-        if(*endptr == '\0')
-            return true;
-        // check if hex
-        result = std::strtol(value.c_str(), &endptr, 16);
-        if(*endptr == '\0')
-            return true;
+    private:
+        const char *data_ = nullptr;
+        std::size_t size_ = 0;
 
-        return false;
-    }
+    public:
+        StringView() = default;
 
-    inline bool strToULong(const std::string &value, unsigned long &result)
-    {
-        char *endptr;
-        // check if decimal
-        result = std::strtoul(value.c_str(), &endptr, 10);
-        if(*endptr == '\0')
-            return true;
-        // check if octal
-        result = std::strtoul(value.c_str(), &endptr, 8);
-        if(*endptr == '\0')
-            return true;
-        // check if hex
-        result = std::strtoul(value.c_str(), &endptr, 16);
-        if(*endptr == '\0')
-            return true;
+        StringView(const char *str) : data_(str), size_(std::strlen(str))
+        {}
 
-        return false;
-    }
+        StringView(const char *str, const std::size_t size) : data_(str), size_(size)
+        {}
 
-    template<typename T>
-    struct Convert
-    {};
+        StringView(const std::string &str) : data_(str.data()), size_(str.size())
+        {}
 
-    template<>
-    struct Convert<bool>
-    {
-        void decode(const std::string &value, bool &result)
+        const char *data() const
         {
-            std::string str(value);
-            std::transform(str.begin(), str.end(), str.begin(), [](const char c){
-                return static_cast<char>(::toupper(c));
-            });
+            return data_;
+        }
 
-            if(str == "TRUE")
-                result = true;
-            else if(str == "FALSE")
-                result = false;
-            else
-                throw std::invalid_argument("field is not a bool");
+        std::size_t size() const
+        {
+            return size_;
         }
 
-        void encode(const bool value, std::string &result)
+        bool empty() const
         {
-            result = value ? "true" : "false";
+            return size_ == 0;
         }
-    };
 
-    template<>
-    struct Convert<char>
-    {
-        void decode(const std::string &value, char &result)
+        const char *begin() const
         {
-            assert(value.size() > 0);
-            result = value[0];
+            return data_;
         }
 
-        void encode(const char value, std::string &result)
+        const char *end() const
         {
-            result = value;
+            return data_ + size_;
         }
-    };
 
-    template<>
-    struct Convert<unsigned char>
-    {
-        void decode(const std::string &value, unsigned char &result)
+        char operator[](const std::size_t idx) const
         {
-            assert(value.size() > 0);
-            result = value[0];
+            return data_[idx];
         }
 
-        void encode(const unsigned char value, std::string &result)
+        int compare(const StringView other) const
         {
-            result = value;
+            const std::size_t size = std::min(size_, other.size_);
+            const int result = size == 0 ? 0 : std::char_traits<char>::compare(data_, other.data_, size);
+            if(result != 0)
+                return result;
+            if(size_ == other.size_)
+                return 0;
+            return size_ < other.size_ ? -1 : 1;
         }
     };
 
-    template<>
-    struct Convert<short>
+    inline bool operator==(const StringView lhs, const StringView rhs)
     {
-        void decode(const std::string &value, short &result)
-        {
-            long tmp;
-            if(!strToLong(value, tmp))
-                throw std::invalid_argument("field is not a short");
-            result = static_cast<short>(tmp);
-        }
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
 
-        void encode(const short value, std::string &result)
-        {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
-        }
-    };
+    inline bool operator!=(const StringView lhs, const StringView rhs)
+    {
+        return !(lhs == rhs);
+    }
 
-    template<>
-    struct Convert<unsigned short>
+    inline bool operator<(const StringView lhs, const StringView rhs)
     {
-        void decode(const std::string &value, unsigned short &result)
-        {
-            unsigned long tmp;
-            if(!strToULong(value, tmp))
-                throw std::invalid_argument("field is not an unsigned short");
-            result = static_cast<unsigned short>(tmp);
-        }
+        return lhs.compare(rhs) < 0;
+    }
+#endif
 
-        void encode(const unsigned short value, std::string &result)
-        {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
-        }
+    /************************************************
+     * File Access
+     ************************************************/
+
+    /** Strategies to read the contents of a file in IniFileBase::load(). */
+    enum class LoadMode
+    {
+        /** Read the file through a std::ifstream. */
+        Stream,
+        /** Memory map the file and parse straight from the mapped pages.
+          * Pipes, special files and platforms without mmap fall back to
+          * reading the file into memory. */
+        Mapped,
+        /** Same as Mapped, but asks the kernel to prefault all pages of the
+          * mapping up front (MAP_POPULATE), if supported. */
+        MappedPopulate
     };
 
-    template<>
-    struct Convert<int>
+    /** Read-only buffer holding the whole contents of a file.
+      * The contents are either memory mapped or read into memory depending on
+      * the requested LoadMode and the type of the file. */
+    class FileBuffer
     {
-        void decode(const std::string &value, int &result)
-        {
-            long tmp;
-            if(!strToLong(value, tmp))
-                throw std::invalid_argument("field is not an int");
-            result = static_cast<int>(tmp);
-        }
+    private:
+        const char *data_ = nullptr;
+        std::size_t size_ = 0;
+        bool mapped_ = false;
+        std::string buffer_;
 
-        void encode(const int value, std::string &result)
+        void useBuffer()
         {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+            mapped_ = false;
         }
-    };
 
-    template<>
-    struct Convert<unsigned int>
-    {
-        void decode(const std::string &value, unsigned int &result)
+        bool readStream(const std::string &fileName)
         {
-            unsigned long tmp;
-            if(!strToULong(value, tmp))
-                throw std::invalid_argument("field is not an unsigned int");
-            result = static_cast<unsigned int>(tmp);
+            std::ifstream is(fileName.c_str(), std::ios::in | std::ios::binary);
+            if(!is.is_open())
+                return false;
+
+            char buffer[4096];
+            while(is.read(buffer, sizeof(buffer)) || is.gcount() > 0)
+                buffer_.append(buffer, static_cast<std::size_t>(is.gcount()));
+            useBuffer();
+            return true;
         }
 
-        void encode(const unsigned int value, std::string &result)
+#ifdef INICPP_HAS_MMAP
+        bool readDescriptor(const int fd)
         {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
+            char buffer[65536];
+            while(true)
+            {
+                ssize_t cnt = ::read(fd, buffer, sizeof(buffer));
+                if(cnt == 0)
+                    break;
+                if(cnt < 0)
+                {
+                    if(errno == EINTR)
+                        continue;
+                    return false;
+                }
+                buffer_.append(buffer, static_cast<std::size_t>(cnt));
+            }
+            useBuffer();
+            return true;
         }
-    };
 
-    template<>
-    struct Convert<long>
-    {
-        void decode(const std::string &value, long &result)
+        bool readMapped(const std::string &fileName, const bool populate)
         {
-            if(!strToLong(value, result))
-                throw std::invalid_argument("field is not a long");
+            int fd = ::open(fileName.c_str(), O_RDONLY);
+            if(fd < 0)
+                return false;
+
+            struct stat st;
+            bool result = false;
+            // only regular files can be mapped reliably, special files like
+            // pipes or procfs entries have to be read
+            if(::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+            {
+                int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+                if(populate)
+                    flags |= MAP_POPULATE;
+#else
+                (void) populate;
+#endif
+                const std::size_t size = static_cast<std::size_t>(st.st_size);
+                void *addr = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+                if(addr != MAP_FAILED)
+                {
+#ifdef MADV_SEQUENTIAL
+                    // the parser reads the file strictly front to back
+                    ::madvise(addr, size, MADV_SEQUENTIAL);
+#endif
+                    data_ = static_cast<const char *>(addr);
+                    size_ = size;
+                    mapped_ = true;
+                    result = true;
+                }
+            }
+
+            if(!result)
+                result = readDescriptor(fd);
+            ::close(fd);
+            return result;
         }
+#endif
 
-        void encode(const long value, std::string &result)
+    public:
+        FileBuffer() = default;
+
+        FileBuffer(const std::string &fileName, const LoadMode mode = LoadMode::Stream)
         {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
+            open(fileName, mode);
         }
-    };
 
-    template<>
-    struct Convert<unsigned long>
-    {
-        void decode(const std::string &value, unsigned long &result)
+        FileBuffer(const FileBuffer &) = delete;
+        FileBuffer &operator=(const FileBuffer &) = delete;
+
+        ~FileBuffer()
         {
-            if(!strToULong(value, result))
-                throw std::invalid_argument("field is not an unsigned long");
+            close();
         }
 
-        void encode(const unsigned long value, std::string &result)
+        /** Opens the file at the given path and makes its contents available.
+          * @param fileName path to the file that should be read.
+          * @param mode strategy used to read the file.
+          * @return true if the file could be read, false otherwise. */
+        bool open(const std::string &fileName, const LoadMode mode = LoadMode::Stream)
         {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
+            close();
+#ifdef INICPP_HAS_MMAP
+            if(mode != LoadMode::Stream)
+                return readMapped(fileName, mode == LoadMode::MappedPopulate);
+#else
+            (void) mode;
+#endif
+            return readStream(fileName);
         }
-    };
 
-    template<>
-    struct Convert<double>
-    {
-        void decode(const std::string &value, double &result)
+        /** Releases the file contents. */
+        void close()
         {
-            result = std::stod(value);
+#ifdef INICPP_HAS_MMAP
+            if(mapped_)
+                ::munmap(const_cast<char *>(data_), size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+            mapped_ = false;
+            buffer_.clear();
         }
 
-        void encode(const double value, std::string &result)
+        /** Returns a pointer to the file contents. */
+        const char *data() const
         {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
+            return data_;
         }
-    };
 
-    template<>
-    struct Convert<float>
-    {
-        void decode(const std::string &value, float &result)
+        /** Returns the number of bytes in the file. */
+        std::size_t size() const
         {
-            result = std::stof(value);
+            return size_;
         }
 
-        void encode(const float value, std::string &result)
+        /** Returns true if the file contents are memory mapped. */
+        bool mapped() const
         {
-            std::stringstream ss;
-            ss << value;
-            result = ss.str();
+            return mapped_;
         }
     };
 
-    template<>
-    struct Convert<std::string>
-    {
-        void decode(const std::string &value, std::string &result)
-        {
-            result = value;
-        }
+    /************************************************
+     * Byte Scanning
+     ************************************************/
 
-        void encode(const std::string &value, std::string &result)
-        {
-            result = value;
-        }
+    /** Maximum number of distinct bytes ByteScanner compares using SIMD. */
+    constexpr std::size_t ByteScannerMaxBytes = 8;
+
+    /** Instruction sets which can be used by ByteScanner. */
+    enum class ScanKernel
+    {
+        /** Portable implementation using a lookup table. */
+        Scalar,
+        /** Compares blocks of 16 bytes using SSE2. */
+        SSE2,
+        /** Compares blocks of 32 bytes using AVX2. */
+        AVX2
     };
 
-#ifdef __cpp_lib_string_view
-    template<>
-    struct Convert<std::string_view>
+    /** Returns the first byte in [begin, end) for which the lookup table is set. */
+    inline const char *findBytesScalar(const char *begin, const char *end, const bool *table)
     {
-        void decode(const std::string &value, std::string_view &result)
-        {
-            result = value;
-        }
+        while(begin != end && !table[static_cast<unsigned char>(*begin)])
+            ++begin;
+        return begin;
+    }
 
-        void encode(const std::string_view value, std::string &result)
-        {
-            result = value;
-        }
-    };
+#ifdef INICPP_HAS_SSE2
+    inline int countTrailingZeros(const unsigned int mask)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long result;
+        _BitScanForward(&result, mask);
+        return static_cast<int>(result);
+#else
+        return __builtin_ctz(mask);
 #endif
+    }
 
-    template<>
-    struct Convert<const char*>
+    /** Returns the first byte in [begin, end) which equals one of the given
+      * bytes. Compares blocks of 16 bytes at once. */
+    inline const char *findBytesSSE2(
+        const char *begin, const char *end, const char *bytes, const std::size_t count, const bool *table)
     {
-        void encode(const char* const &value, std::string &result)
-        {
-            result = value;
-        }
+        __m128i needles[ByteScannerMaxBytes];
+        for(std::size_t i = 0; i < count; ++i)
+            needles[i] = _mm_set1_epi8(bytes[i]);
 
-        void decode(const std::string &value, const char* &result)
+        while(end - begin >= 16)
         {
-            result = value.c_str();
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+            __m128i matches = _mm_cmpeq_epi8(block, needles[0]);
+            for(std::size_t i = 1; i < count; ++i)
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+            const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+            if(mask != 0)
+                return begin + countTrailingZeros(mask);
+            begin += 16;
         }
-    };
 
-    template<>
-    struct Convert<char*>
+        return findBytesScalar(begin, end, table);
+    }
+#endif
+
+#ifdef INICPP_HAS_AVX2
+    /** Returns the first byte in [begin, end) which equals one of the given
+      * bytes. Compares blocks of 32 bytes at once.
+      * Must only be called if the CPU supports AVX2. */
+    __attribute__((target("avx2"))) inline const char *findBytesAVX2(
+        const char *begin, const char *end, const char *bytes, const std::size_t count, const bool *table)
     {
-        void encode(const char* const &value, std::string &result)
+        __m256i needles[ByteScannerMaxBytes];
+        for(std::size_t i = 0; i < count; ++i)
+            needles[i] = _mm256_set1_epi8(bytes[i]);
+
+        while(end - begin >= 32)
         {
-            result = value;
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+            __m256i matches = _mm256_cmpeq_epi8(block, needles[0]);
+            for(std::size_t i = 1; i < count; ++i)
+                matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[i]));
+            const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(matches));
+            if(mask != 0)
+                return begin + countTrailingZeros(mask);
+            begin += 32;
         }
-    };
 
-    template<size_t n>
-    struct Convert<char[n]>
+        return findBytesSSE2(begin, end, bytes, count, table);
+    }
+#endif
+
+    /** Returns the fastest scan kernel supported by the CPU at runtime. */
+    inline ScanKernel bestScanKernel()
     {
-        void encode(const char *value, std::string &result)
+#if defined(INICPP_HAS_AVX2)
+        static const ScanKernel kernel = __builtin_cpu_supports("avx2") ? ScanKernel::AVX2 : ScanKernel::SSE2;
+        return kernel;
+#elif defined(INICPP_HAS_SSE2)
+        return ScanKernel::SSE2;
+#else
+        return ScanKernel::Scalar;
+#endif
+    }
+
+    /** Returns true if the given scan kernel can be used on this CPU. */
+    inline bool isScanKernelSupported(const ScanKernel kernel)
+    {
+        switch(kernel)
         {
-            result = value;
+        case ScanKernel::AVX2:
+            return bestScanKernel() == ScanKernel::AVX2;
+        case ScanKernel::SSE2:
+            return bestScanKernel() != ScanKernel::Scalar;
+        default:
+            return true;
         }
-    };
+    }
 
-    class IniField
+    /** Finds the bytes of a small set in a character buffer.
+      * The decoder uses it to jump straight to the bytes which carry structure
+      * (newlines, brackets, field separators, escape chars and the first byte
+      * of each comment prefix) in a single pass over the buffer. Up to
+      * ByteScannerMaxBytes bytes are compared in blocks using SSE2 or AVX2,
+      * larger sets and CPUs without SIMD support fall back to a lookup table. */
+    class ByteScanner
     {
     private:
-        std::string value_;
+        bool table_[256];
+        char bytes_[ByteScannerMaxBytes];
+        std::size_t count_ = 0;
+        ScanKernel kernel_;
 
     public:
-        IniField() : value_()
+        ByteScanner() : ByteScanner(StringView())
         {}
 
-        IniField(const std::string &value) : value_(value)
-        {}
-        IniField(const IniField &field) : value_(field.value_)
-        {}
-
-        ~IniField()
-        {}
+        /** Creates a scanner for the given set of bytes. */
+        explicit ByteScanner(const StringView bytes) : table_(), kernel_(bestScanKernel())
+        {
+            for(const char c : bytes)
+            {
+                bool &entry = table_[static_cast<unsigned char>(c)];
+                if(entry)
+                    continue;
+                entry = true;
+                if(count_ < ByteScannerMaxBytes)
+                    bytes_[count_] = c;
+                ++count_;
+            }
+        }
 
-        template<typename T>
-        T as() const
+        /** Forces the scanner to use the given kernel.
+          * Falls back to the scalar kernel if the CPU does not support it. */
+        void setKernel(const ScanKernel kernel)
         {
-            Convert<T> conv;
-            T result;
-            conv.decode(value_, result);
-            return result;
+            kernel_ = isScanKernelSupported(kernel) ? kernel : ScanKernel::Scalar;
         }
 
-        template<typename T>
-        IniField &operator=(const T &value)
+        ScanKernel kernel() const
         {
-            Convert<T> conv;
-            conv.encode(value, value_);
-            return *this;
+            return kernel_;
         }
 
-        IniField &operator=(const IniField &field)
+        /** Returns true if the given byte is part of the set. */
+        bool contains(const char c) const
         {
-            value_ = field.value_;
-            return *this;
+            return table_[static_cast<unsigned char>(c)];
         }
-    };
 
-    struct StringInsensitiveLess
-    {
-        bool operator()(std::string lhs, std::string rhs) const
+        /** Returns a pointer to the first byte in [begin, end) which is part
+          * of the set or end if there is none. */
+        const char *find(const char *begin, const char *end) const
         {
-                std::transform(lhs.begin(), lhs.end(), lhs.begin(), [](const char c){
-                    return static_cast<char>(::tolower(c));
-                });
-                std::transform(rhs.begin(), rhs.end(), rhs.begin(), [](const char c){
-                    return static_cast<char>(::tolower(c));
-                });
-                return  lhs < rhs;
+            if(count_ == 0)
+                return end;
+            if(count_ > ByteScannerMaxBytes)
+                return findBytesScalar(begin, end, table_);
+
+            switch(kernel_)
+            {
+#ifdef INICPP_HAS_AVX2
+            case ScanKernel::AVX2:
+                return findBytesAVX2(begin, end, bytes_, count_, table_);
+#endif
+#ifdef INICPP_HAS_SSE2
+            case ScanKernel::SSE2:
+                return findBytesSSE2(begin, end, bytes_, count_, table_);
+#endif
+            default:
+                return findBytesScalar(begin, end, table_);
+            }
         }
     };
 
-    template <typename Comparator>
-    class IniSectionBase : public std::map<std::string, IniField, Comparator>
+    /** Matches a set of comment prefixes against a position in a buffer.
+      * The prefixes are bucketed by their first byte when the matcher is
+      * built, so matching a position only looks at the prefixes which start
+      * with the byte at this position. If several prefixes match, the one
+      * which comes first in the original list wins. */
+    class CommentMatcher
     {
+    private:
+        // prefixes sorted by their first byte, keeping the original order
+        // within each bucket
+        std::vector<std::string> prefixes_;
+        // prefixes_[offsets_[c] .. offsets_[c + 1]] start with byte c
+        std::vector<std::size_t> offsets_;
+        std::string firstBytes_;
+
     public:
-        IniSectionBase()
+        CommentMatcher() : offsets_(257, 0)
         {}
-        ~IniSectionBase()
-        {}
-    };
 
-    using IniSection = IniSectionBase<std::less<std::string>>;
-    using IniSectionCaseInsensitive = IniSectionBase<StringInsensitiveLess>;
+        explicit CommentMatcher(const std::vector<std::string> &prefixes) : offsets_(257, 0)
+        {
+            for(const std::string &prefix : prefixes)
+            {
+                if(!prefix.empty())
+                    prefixes_.push_back(prefix);
+            }
+            std::stable_sort(prefixes_.begin(), prefixes_.end(), [](const std::string &lhs, const std::string &rhs) {
+                return static_cast<unsigned char>(lhs[0]) < static_cast<unsigned char>(rhs[0]);
+            });
 
-    template <typename Comparator>
-    class IniFileBase : public std::map<std::string, IniSectionBase<Comparator>, Comparator>
-    {
-    private:
-        char fieldSep_ = '=';
-        char esc_ = '\\';
-        std::vector<std::string> commentPrefixes_ = { "#" , ";" };
-        bool multiLineValues_ = false;
-        bool overwriteDuplicateFields_ = true;
-
-        void eraseComment(const std::string &commentPrefix,
-            std::string &str,
-            std::string::size_type startpos = 0)
-        {
-            size_t prefixpos = str.find(commentPrefix, startpos);
-            if(std::string::npos == prefixpos)
-                return;
-            // Found a comment prefix, is it escaped?
-            if(0 != prefixpos && str[prefixpos - 1] == esc_)
+            for(const std::string &prefix : prefixes_)
             {
-                // The comment prefix is escaped, so just delete the escape char
-                // and keep erasing after the comment prefix
-                str.erase(prefixpos - 1, 1);
-                eraseComment(
-                    commentPrefix, str, prefixpos - 1 + commentPrefix.size());
-            }
-            else
-            {
-                str.erase(prefixpos);
+                const unsigned char c = static_cast<unsigned char>(prefix[0]);
+                if(offsets_[c + 1] == 0)
+                    firstBytes_ += prefix[0];
+                ++offsets_[c + 1];
             }
+            for(std::size_t i = 1; i < offsets_.size(); ++i)
+                offsets_[i] += offsets_[i - 1];
         }
 
-        void eraseComments(std::string &str)
+        /** Returns the first byte of each comment prefix. */
+        const std::string &firstBytes() const
         {
-            for(const std::string &commentPrefix : commentPrefixes_)
-                eraseComment(commentPrefix, str);
+            return firstBytes_;
         }
 
-        /** Tries to find a suitable comment prefix for the string data at the given
-          * position. Returns commentPrefixes_.end() if not match was found. */
-        std::vector<std::string>::const_iterator findCommentPrefix(const std::string &str,
-            const std::size_t startpos) const
+        /** Returns the comment prefix which starts at pos or nullptr if there
+          * is none. The prefix has to end before end. */
+        const std::string *match(const char *pos, const char *end) const
         {
-            // if startpos is invalid simply return "not found"
-            if(startpos >= str.size())
-                return commentPrefixes_.end();
+            if(pos == end)
+                return nullptr;
 
-            for(size_t i = 0; i < commentPrefixes_.size(); ++i)
+            const unsigned char c = static_cast<unsigned char>(*pos);
+            const std::size_t len = static_cast<std::size_t>(end - pos);
+            for(std::size_t i = offsets_[c]; i < offsets_[c + 1]; ++i)
             {
-                const std::string &prefix = commentPrefixes_[i];
-                // if this comment prefix is longer than the string view itself
-                // then skip
-                if(prefix.size() + startpos > str.size())
-                    continue;
+                const std::string &prefix = prefixes_[i];
+                if(prefix.size() <= len &&
+                    std::char_traits<char>::compare(pos + 1, prefix.data() + 1, prefix.size() - 1) == 0)
+                    return &prefix;
+            }
+            return nullptr;
+        }
+    };
 
-                bool match = true;
-                for(size_t j = 0; j < prefix.size() && match; ++j)
-                    match = str[startpos + j] == prefix[j];
+#ifdef INICPP_HAS_STATS
+    /************************************************
+     * Statistics
+     ************************************************/
 
-                if(match)
-                    return commentPrefixes_.begin() + i;
-            }
+    /** Number and total size of heap allocations. */
+    struct IniAllocationCount
+    {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+    };
 
-            return commentPrefixes_.end();
-        }
+    /** Counters and phase timings of a single decode or encode of an ini
+      * file. The phases do not overlap: read is the time spent reading files
+      * and streams, tokenize the time spent splitting lines into names and
+      * values, insert the time spent storing sections and fields and convert
+      * the time spent unescaping or escaping names and values. The phase
+      * times of a parallel decode are summed over all threads, so they can
+      * exceed the total time. */
+    struct IniStats
+    {
+        // bytes and lines which were decoded or encoded
+        std::size_t bytes = 0;
+        std::size_t lines = 0;
+        // sections and fields which were created or encoded
+        std::size_t sections = 0;
+        std::size_t fields = 0;
+        std::size_t comments = 0;
+        // lines which continued a multi-line value
+        std::size_t continuations = 0;
+        // fields which overwrote a field of the same name
+        std::size_t duplicates = 0;
+        std::chrono::nanoseconds readTime = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds tokenizeTime = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds insertTime = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds convertTime = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds totalTime = std::chrono::nanoseconds(0);
+        // reported by IniObserver::allocations()
+        std::size_t allocations = 0;
+        std::size_t allocatedBytes = 0;
 
-        void writeEscaped(std::ostream &os, const std::string &str) const
+        /** Adds the counters and phase timings of the given statistics. */
+        IniStats &operator+=(const IniStats &stats)
         {
-            for(size_t i = 0; i < str.length(); ++i)
-            {
-                auto prefixpos = findCommentPrefix(str, i);
-                // if no suitable prefix was found at this position
-                // then simply write the current character
-                if(prefixpos != commentPrefixes_.end())
-                {
-                    const std::string &prefix = *prefixpos;
-                    os.put(esc_);
-                    os.write(prefix.c_str(), prefix.size());
-                    i += prefix.size() - 1;
-                }
-                else if (multiLineValues_ && str[i] == '\n')
-                    os.write("\n\t", 2);
-                else
-                    os.put(str[i]);
-            }
+            bytes += stats.bytes;
+            lines += stats.lines;
+            sections += stats.sections;
+            fields += stats.fields;
+            comments += stats.comments;
+            continuations += stats.continuations;
+            duplicates += stats.duplicates;
+            readTime += stats.readTime;
+            tokenizeTime += stats.tokenizeTime;
+            insertTime += stats.insertTime;
+            convertTime += stats.convertTime;
+            totalTime += stats.totalTime;
+            allocations += stats.allocations;
+            allocatedBytes += stats.allocatedBytes;
+            return *this;
         }
+    };
 
+    /** Receives the statistics of each decode and encode of the ini files it
+      * is attached to. Statistics are only reported for operations which
+      * succeed. The callbacks are invoked on the thread which decoded or
+      * encoded the file. */
+    class IniObserver
+    {
     public:
-        IniFileBase() = default;
+        virtual ~IniObserver() = default;
 
-        IniFileBase(const char fieldSep, const char comment)
-            : fieldSep_(fieldSep), commentPrefixes_(1, std::string(1, comment))
+        /** Called after a file was decoded from a buffer, a stream or a
+          * file and after each section of a lazily loaded file was decoded. */
+        virtual void onDecode(const IniStats &)
         {}
 
-        IniFileBase(const std::string &filename)
+        /** Called after a file was encoded. */
+        virtual void onEncode(const IniStats &)
+        {}
+
+        /** Returns the number and size of all allocations made so far. The
+          * library cannot see the allocations of the process, so the default
+          * reports none. Override it with the counters of a replaced
+          * operator new or of the allocator in use to fill the allocation
+          * statistics. */
+        virtual IniAllocationCount allocations() const
         {
-            load(filename);
+            return IniAllocationCount();
         }
+    };
 
-        IniFileBase(std::istream &is)
+    /** Adds the time between its construction and its destruction to the
+      * given duration. Does nothing if the duration is nullptr, so phases
+      * are only timed while an observer is attached. */
+    class IniStatsTimer
+    {
+    private:
+        std::chrono::nanoseconds *duration_;
+        std::chrono::steady_clock::time_point start_;
+
+    public:
+        explicit IniStatsTimer(std::chrono::nanoseconds *duration) : duration_(duration)
         {
-            decode(is);
+            if(duration_ != nullptr)
+                start_ = std::chrono::steady_clock::now();
         }
 
-        IniFileBase(const char fieldSep,
-            const std::vector<std::string> &commentPrefixes)
-            : fieldSep_(fieldSep), commentPrefixes_(commentPrefixes)
-        {}
+        IniStatsTimer(const IniStatsTimer &) = delete;
+        IniStatsTimer &operator=(const IniStatsTimer &) = delete;
 
-        IniFileBase(const std::string &filename,
-            const char fieldSep,
-            const std::vector<std::string> &commentPrefixes)
-            : fieldSep_(fieldSep), commentPrefixes_(commentPrefixes)
+        ~IniStatsTimer()
         {
-            load(filename);
+            if(duration_ != nullptr)
+                *duration_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_);
         }
+    };
 
-        IniFileBase(std::istream &is,
-            const char fieldSep,
-            const std::vector<std::string> &commentPrefixes)
-            : fieldSep_(fieldSep), commentPrefixes_(commentPrefixes)
+    /** Collects the statistics of a single operation and reports them to an
+      * observer when the operation is finished. */
+    class IniStatsScope
+    {
+    private:
+        IniObserver &observer_;
+        IniStats stats_;
+        const IniAllocationCount allocations_;
+        const std::chrono::steady_clock::time_point start_;
+
+        void finish()
         {
-            decode(is);
+            stats_.totalTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_);
+            const IniAllocationCount allocations = observer_.allocations();
+            stats_.allocations = allocations.count - allocations_.count;
+            stats_.allocatedBytes = allocations.bytes - allocations_.bytes;
         }
 
-        ~IniFileBase()
+    public:
+        explicit IniStatsScope(IniObserver &observer)
+            : observer_(observer), allocations_(observer.allocations()), start_(std::chrono::steady_clock::now())
         {}
 
-        /** Sets the separator charactor for fields in the INI file.
-          * @param sep separator character to be used. */
-        void setFieldSep(const char sep)
+        IniStats &stats()
         {
-            fieldSep_ = sep;
+            return stats_;
         }
 
-        /** Sets the character that should be interpreted as the start of comments.
-          * Default is '#'.
-          * Note: If the inifile contains the comment character as data it must be prefixed with
-          * the configured escape character.
-          * @param comment comment character to be used. */
-        void setCommentChar(const char comment)
+        void finishDecode()
         {
-            commentPrefixes_ = {std::string(1, comment)};
+            finish();
+            observer_.onDecode(stats_);
         }
 
-        /** Sets the list of strings that should be interpreted as the start of comments.
-          * Default is [ "#" ].
-          * Note: If the inifile contains any comment string as data it must be prefixed with
-          * the configured escape character.
-          * @param commentPrefixes vector of comment prefix strings to be used. */
-        void setCommentPrefixes(const std::vector<std::string> &commentPrefixes)
+        void finishEncode()
         {
-            commentPrefixes_ = commentPrefixes;
+            finish();
+            observer_.onEncode(stats_);
         }
+    };
+#endif
 
-        /** Sets the character that should be used to escape comment prefixes.
-          * Default is '\'.
-          * @param esc escape character to be used. */
-        void setEscapeChar(const char esc)
+    /************************************************
+     * Event Parser
+     ************************************************/
+
+    /** Throws the error for a line which could not be parsed. */
+    inline void throwParseError(const int lineNo, const std::string &msg)
+    {
+        std::stringstream ss;
+        ss << "l." << lineNo << ": ini parsing failed, " << msg;
+        throw std::logic_error(ss.str());
+    }
+
+    /** Receives the events of an IniParser. The default implementations
+      * ignore all events, so handlers can derive from this class and only
+      * hide the callbacks they are interested in. Each callback returns true
+      * to continue parsing or false to stop. The views passed to a callback
+      * point into the parsed buffer or into scratch memory of the parser and
+      * are only valid until the callback returns. */
+    struct IniHandler
+    {
+        /** Called for each section header with the unescaped section name. */
+        bool onSection(const StringView, const int)
         {
-            esc_ = esc;
+            return true;
         }
 
-        /** Sets whether or not to parse multi-line field values.
-          * Default is false.
-          * @param enable enable or disable? */
-        void setMultiLineValues(bool enable)
+        /** Called for each field with its unescaped name and value. If
+          * multi-line values are enabled, a field is reported once its value
+          * is complete, i.e. after the comments within its continuation lines. */
+        bool onField(const StringView, const StringView, const int)
         {
-            multiLineValues_ = enable;
+            return true;
         }
 
-        /** Sets whether or not overwriting duplicate fields is allowed.
-          * If overwriting duplicate fields is not allowed,
-          * an exception is thrown when a duplicate field is found inside a section.
-          * Default is true.
-          * @param allowed Is overwriting duplicate fields allowed or not? */
-        void allowOverwriteDuplicateFields(bool allowed)
+        /** Called for each comment with the trimmed text after its prefix. */
+        bool onComment(const StringView, const int)
         {
-            overwriteDuplicateFields_ = allowed;
+            return true;
         }
 
-        /** Tries to decode a ini file from the given input stream.
-          * @param is input stream from which data should be read. */
-        void decode(std::istream &is)
+        /** Called for each malformed line. Returning true skips the line and
+          * continues parsing. */
+        bool onError(const StringView, const int)
+        {
+            return false;
+        }
+    };
+
+    /** Event driven parser for the ini format. The parser tokenizes a buffer
+      * or a stream line by line and reports sections, fields, comments and
+      * errors to a handler without building a document, so memory usage does
+      * not depend on the size of the input. Parsing is const, a parser can be
+      * shared by several threads. */
+    class IniParser
+    {
+    private:
+        /** State of a single parse which is carried from line to line. */
+        struct ParseState
         {
-            this->clear();
             int lineNo = 0;
-            IniSectionBase<Comparator> *currentSection = nullptr;
-            std::string mutliLineValueFieldName = "";
-            std::string line;
-            // iterate file line by line
-            while(!is.eof() && !is.fail())
-            {
-                std::getline(is, line, '\n');
-                eraseComments(line);
-                bool hasIndent = line.find_first_not_of(indents()) != 0;
-                trim(line);
-                ++lineNo;
+            bool inSection = false;
+            // field which is potentially continued by a multi-line value
+            bool pending = false;
+            int pendingLineNo = 0;
+            StringView pendingName;
+            StringView pendingValue;
+            // scratch memory for unescaped names and values
+            std::string sectionBuffer;
+            std::string nameBuffer;
+            std::string valueBuffer;
+#ifdef INICPP_HAS_STATS
+            // receives the counters and timings if the parse is observed
+            IniStats *stats = nullptr;
+#endif
+        };
 
-                // skip if line is empty
-                if(line.size() == 0)
-                    continue;
+        char fieldSep_ = '=';
+        char esc_ = '\\';
+        std::vector<std::string> commentPrefixes_ = { "#" , ";" };
+        bool multiLineValues_ = false;
+        CommentMatcher commentMatcher_ = CommentMatcher(commentPrefixes_);
+        // finds the structural bytes of a line
+        ByteScanner scanner_ = makeScanner();
+        // finds the bytes which have to be escaped when encoding
+        ByteScanner escapeScanner_ = makeEscapeScanner();
 
-                if(line[0] == '[')
-                {
-                    // line is a section
-                    // check if the section is also closed on same line
-                    std::size_t pos = line.find("]");
-                    if(pos == std::string::npos)
-                    {
-                        std::stringstream ss;
-                        ss << "l." << lineNo
-                           << ": ini parsing failed, section not closed";
-                        throw std::logic_error(ss.str());
-                    }
-                    // check if the section name is empty
-                    if(pos == 1)
-                    {
-                        std::stringstream ss;
-                        ss << "l." << lineNo
-                           << ": ini parsing failed, section is empty";
-                        throw std::logic_error(ss.str());
-                    }
+        /** Creates a scanner which finds all bytes that carry structure in
+          * a line of the current ini format. */
+        ByteScanner makeScanner() const
+        {
+            std::string bytes = "\n]";
+            bytes += fieldSep_;
+            bytes += esc_;
+            bytes += commentMatcher_.firstBytes();
+            return ByteScanner(bytes);
+        }
+
+        /** Creates a scanner which finds all bytes that have to be escaped
+          * when encoding. */
+        ByteScanner makeEscapeScanner() const
+        {
+            return ByteScanner(commentMatcher_.firstBytes() + '\n');
+        }
+
+        /** Rebuilds the comment matcher and the scanners after the format
+          * was changed. */
+        void updateSyntax()
+        {
+            const ScanKernel kernel = scanner_.kernel();
+            commentMatcher_ = CommentMatcher(commentPrefixes_);
+            scanner_ = makeScanner();
+            scanner_.setKernel(kernel);
+            escapeScanner_ = makeEscapeScanner();
+            escapeScanner_.setKernel(kernel);
+        }
 
-                    // retrieve section name
-                    std::string secName = line.substr(1, pos - 1);
-                    currentSection = &((*this)[secName]);
+        /** Appends the range [begin, end) to the given string and removes all
+          * escape chars which precede a comment prefix. */
+        void appendUnescaped(std::string &str, const char *begin, const char *end) const
+        {
+            // allocate at most once, even if escape chars are dropped, and
+            // grow geometrically when appending to a non-empty string, so
+            // repeated appends run in amortized linear time
+            const std::size_t required = str.size() + static_cast<std::size_t>(end - begin);
+            if(required > str.capacity())
+                str.reserve(str.empty() ? required : std::max(required, 2 * str.capacity()));
+            const char *chunk = begin;
+            const char *pos = begin;
+            while(pos != end)
+            {
+                pos = static_cast<const char *>(std::memchr(pos, esc_, static_cast<std::size_t>(end - pos)));
+                if(pos == nullptr)
+                    break;
 
-                    // clear multiline value field name
-                    // a new section means there is no value to continue
-                    mutliLineValueFieldName = "";
+                const std::string *prefix = commentMatcher_.match(pos + 1, end);
+                if(prefix != nullptr)
+                {
+                    // flush everything up to the escape char and continue
+                    // with the comment prefix itself
+                    str.append(chunk, pos);
+                    chunk = pos + 1;
+                    pos += 1 + prefix->size();
                 }
                 else
                 {
-                    // line is a field definition
-                    // check if section was already opened
-                    if(currentSection == nullptr)
-                    {
-                        std::stringstream ss;
-                        ss << "l." << lineNo
-                           << ": ini parsing failed, field has no section"
-                                " or ini file in use by another application";
-                        throw std::logic_error(ss.str());
-                    }
+                    ++pos;
+                }
+            }
+            str.append(chunk, end);
+        }
 
-                    // find key value separator
-                    std::size_t pos = line.find(fieldSep_);
-                    if (multiLineValues_ && hasIndent && mutliLineValueFieldName != "")
-                    {
-                        // extend a multi-line value
-                        IniField previous_value = (*currentSection)[mutliLineValueFieldName];
-                        std::string value = previous_value.as<std::string>() + "\n" + line;
-                        (*currentSection)[mutliLineValueFieldName] = value;
-                    }
-                    else if(pos == std::string::npos)
+        /** Returns the range [begin, end) without escape chars. The range is
+          * returned as is if it contains no escape char, otherwise it is
+          * unescaped into the given buffer. */
+        StringView unescape(const char *begin, const char *end, std::string &buffer, ParseState &state) const
+        {
+            const std::size_t size = static_cast<std::size_t>(end - begin);
+            if(std::memchr(begin, esc_, size) == nullptr)
+                return StringView(begin, size);
+#ifdef INICPP_HAS_STATS
+            IniStatsTimer timer(state.stats != nullptr ? &state.stats->convertTime : nullptr);
+#else
+            (void) state;
+#endif
+            buffer.clear();
+            appendUnescaped(buffer, begin, end);
+            return StringView(buffer);
+        }
+
+        /** Removes all leading and trailing whitespace from the range [begin, end). */
+        static void trimRange(const char *&begin, const char *&end)
+        {
+            while(end != begin && isWhitespace(*(end - 1)))
+                --end;
+            while(begin != end && isWhitespace(*begin))
+                ++begin;
+        }
+
+        /** Copies the pending field into the scratch buffers of the state, so
+          * it outlives the buffer it was parsed from. */
+        static void pinPending(ParseState &state)
+        {
+            if(!state.pending)
+                return;
+            if(state.pendingName.data() != state.nameBuffer.data())
+            {
+                state.nameBuffer.assign(state.pendingName.data(), state.pendingName.size());
+                state.pendingName = StringView(state.nameBuffer);
+            }
+            if(state.pendingValue.data() != state.valueBuffer.data())
+            {
+                state.valueBuffer.assign(state.pendingValue.data(), state.pendingValue.size());
+                state.pendingValue = StringView(state.valueBuffer);
+            }
+        }
+
+        /** Reports the pending field, if any. */
+        template<typename Handler>
+        static bool flushPending(ParseState &state, Handler &handler)
+        {
+            if(!state.pending)
+                return true;
+            state.pending = false;
+            return handler.onField(state.pendingName, state.pendingValue, state.pendingLineNo);
+        }
+
+        /** Parses the trimmed, non-empty content [begin, end) of a line. */
+        template<typename Handler>
+        bool parseLine(const char *begin,
+            const char *end,
+            const char *sep,
+            const char *close,
+            const bool hasIndent,
+            ParseState &state,
+            Handler &handler) const
+        {
+            if(*begin == '[')
+            {
+                // line is a section, so there is no value to continue
+                if(!flushPending(state, handler))
+                    return false;
+                // check if the section is also closed on same line
+                if(close == nullptr)
+                    return handler.onError(StringView("section not closed"), state.lineNo);
+                // check if the section name is empty
+                if(close == begin + 1)
+                    return handler.onError(StringView("section is empty"), state.lineNo);
+
+                state.inSection = true;
+                return handler.onSection(unescape(begin + 1, close, state.sectionBuffer, state), state.lineNo);
+            }
+
+            // line is a field definition
+            // check if section was already opened
+            if(!state.inSection)
+                return handler.onError(
+                    StringView("field has no section or ini file in use by another application"), state.lineNo);
+
+            if(multiLineValues_ && hasIndent && state.pending)
+            {
+                // extend the pending value, the scratch buffer is used as
+                // append buffer
+                pinPending(state);
+#ifdef INICPP_HAS_STATS
+                IniStatsTimer timer(state.stats != nullptr ? &state.stats->convertTime : nullptr);
+                if(state.stats != nullptr)
+                    ++state.stats->continuations;
+#endif
+                state.valueBuffer += '\n';
+                appendUnescaped(state.valueBuffer, begin, end);
+                state.pendingValue = StringView(state.valueBuffer);
+                return true;
+            }
+
+            if(!flushPending(state, handler))
+                return false;
+
+            if(sep == nullptr)
+            {
+                std::string msg = "no '";
+                msg += fieldSep_;
+                msg += "' found";
+                if(multiLineValues_)
+                    msg += ", and not a multi-line value continuation";
+                return handler.onError(StringView(msg), state.lineNo);
+            }
+
+            // retrieve field name and value
+            const char *nameBegin = begin;
+            const char *nameEnd = sep;
+            trimRange(nameBegin, nameEnd);
+            const char *valueBegin = sep + 1;
+            const char *valueEnd = end;
+            trimRange(valueBegin, valueEnd);
+            const StringView name = unescape(nameBegin, nameEnd, state.nameBuffer, state);
+            const StringView value = unescape(valueBegin, valueEnd, state.valueBuffer, state);
+            if(!multiLineValues_)
+                return handler.onField(name, value, state.lineNo);
+
+            // keep the field until it is known whether it is continued
+            state.pending = true;
+            state.pendingLineNo = state.lineNo;
+            state.pendingName = name;
+            state.pendingValue = value;
+            return true;
+        }
+
+        /** Parses all lines in [data, dataEnd). The last line does not need
+          * to be terminated by a newline. */
+        template<typename Handler>
+        bool parseLines(const char *data, const char *dataEnd, ParseState &state, Handler &handler) const
+        {
+            const char *pos = data;
+            // iterate buffer line by line
+            while(pos != dataEnd)
+            {
+                const char *begin = pos;
+                const char *end = nullptr;
+                const char *sep = nullptr;
+                const char *close = nullptr;
+                const char *comment = nullptr;
+                // jump from one structural byte to the next until the end of
+                // the line or the start of a comment
+                const char *cur = begin;
+                while(end == nullptr)
+                {
+                    cur = scanner_.find(cur, dataEnd);
+                    if(cur == dataEnd || *cur == '\n')
                     {
-                        std::stringstream ss;
-                        ss << "l." << lineNo
-                           << ": ini parsing failed, no '"
-                           << fieldSep_
-                           << "' found";
-                        if (multiLineValues_)
-                            ss << ", and not a multi-line value continuation";
-                        throw std::logic_error(ss.str());
+                        end = cur;
+                        break;
                     }
-                    else
+
+                    const std::string *prefix = commentMatcher_.match(cur, dataEnd);
+                    if(prefix != nullptr)
                     {
-                        // retrieve field name and value
-                        std::string name = line.substr(0, pos);
-                        trim(name);
-                        if (!overwriteDuplicateFields_ && currentSection->count(name) != 0)
+                        // Found a comment prefix, is it escaped?
+                        if(cur == begin || *(cur - 1) != esc_)
                         {
-                            std::stringstream ss;
-                            ss << "l." << lineNo
-                               << ": ini parsing failed, duplicate field found";
-                            throw std::logic_error(ss.str());
+                            end = cur;
+                            comment = cur + prefix->size();
+                            cur = static_cast<const char *>(
+                                std::memchr(comment, '\n', static_cast<std::size_t>(dataEnd - comment)));
+                            if(cur == nullptr)
+                                cur = dataEnd;
+                            break;
                         }
-                        std::string value = line.substr(pos + 1, std::string::npos);
-                        trim(value);
-                        (*currentSection)[name] = value;
-                        // store last field name for potential multi-line values
-                        mutliLineValueFieldName = name;
+                        // The comment prefix is escaped, so keep searching
+                        // after it
+                        cur += prefix->size();
+                        continue;
                     }
+
+                    if(*cur == fieldSep_ && sep == nullptr)
+                        sep = cur;
+                    else if(*cur == ']' && close == nullptr)
+                        close = cur;
+                    ++cur;
                 }
-            }
-        }
+                pos = cur == dataEnd ? dataEnd : cur + 1;
+                bool hasIndent = begin == end || *begin == ' ' || *begin == '\t';
+                trimRange(begin, end);
+                ++state.lineNo;
+                // a whitespace separator can be found in the indentation or
+                // the trailing whitespace, so search again in the trimmed line
+                if(sep != nullptr && (sep < begin || sep >= end))
+                    sep = static_cast<const char *>(
+                        std::memchr(begin, fieldSep_, static_cast<std::size_t>(end - begin)));
 
-        /** Tries to decode a ini file from the given input string.
-          * @param content string to be decoded. */
-        void decode(const std::string &content)
-        {
-            std::istringstream ss(content);
-            decode(ss);
+                // skip the content if the line is empty
+                if(begin != end && !parseLine(begin, end, sep, close, hasIndent, state, handler))
+                    return false;
+
+                if(comment != nullptr)
+                {
+                    const char *commentEnd = cur;
+                    trimRange(comment, commentEnd);
+                    const StringView text(comment, static_cast<std::size_t>(commentEnd - comment));
+                    if(!handler.onComment(text, state.lineNo))
+                        return false;
+                }
+            }
+            return true;
         }
 
-        /** Tries to load and decode a ini file from the file at the given path.
-          * @param fileName path to the file that should be loaded. */
-        void load(const std::string &fileName)
+        /** Parses a whole buffer including its last pending field. */
+        template<typename Handler>
+        bool parseBuffer(const char *data, const std::size_t size, ParseState &state, Handler &handler) const
         {
-            std::ifstream is(fileName.c_str());
-            decode(is);
+            if(!parseLines(data, data + size, state, handler))
+                return false;
+            return flushPending(state, handler);
         }
 
-        /** Encodes this inifile object and writes the output to the given stream.
-          * @param os target stream. */
-        void encode(std::ostream &os) const
+        /** Parses a stream block by block. */
+        template<typename Handler>
+        bool parseStream(std::istream &is, ParseState &state, Handler &handler) const
         {
-            // iterate through all sections in this file
-            for(const auto &filePair : *this)
+            const std::size_t blockSize = 64 * 1024;
+            std::string buffer;
+            while(true)
             {
-                os.put('[');
-                writeEscaped(os, filePair.first);
-                os.put(']');
-                os.put('\n');
-
-                // iterate through all fields in the section
-                for(const auto &secPair : filePair.second)
+                const std::size_t offset = buffer.size();
+                buffer.resize(offset + blockSize);
                 {
-                    writeEscaped(os, secPair.first);
-                    os.put(fieldSep_);
-                    writeEscaped(os, secPair.second.template as<std::string>());
-                    os.put('\n');
-                } 
+#ifdef INICPP_HAS_STATS
+                    IniStatsTimer timer(state.stats != nullptr ? &state.stats->readTime : nullptr);
+#endif
+                    is.read(&buffer[offset], static_cast<std::streamsize>(blockSize));
+                }
+                const std::size_t count = static_cast<std::size_t>(is.gcount());
+                buffer.resize(offset + count);
+                if(count == 0)
+                    break;
+#ifdef INICPP_HAS_STATS
+                if(state.stats != nullptr)
+                    state.stats->bytes += count;
+#endif
 
-                // Add a newline after each section
-                os.put('\n');
+                // parse all complete lines, the rest is kept for the next block
+                std::size_t complete = buffer.size();
+                while(complete != offset && buffer[complete - 1] != '\n')
+                    --complete;
+                if(complete == offset)
+                    continue;
+                if(!parseLines(buffer.data(), buffer.data() + complete, state, handler))
+                    return false;
+                pinPending(state);
+                buffer.erase(0, complete);
             }
+            if(!parseLines(buffer.data(), buffer.data() + buffer.size(), state, handler))
+                return false;
+            return flushPending(state, handler);
         }
 
-        /** Encodes this inifile object as string and returns the result.
-          * @return encoded infile string. */
-        std::string encode() const
+#ifdef INICPP_HAS_STATS
+        /** Runs the given parse with statistics. The time which was not
+          * spent reading, inserting or converting is added to the tokenize
+          * phase. */
+        template<typename Parse>
+        static bool parseObserved(ParseState &state, IniStats &stats, Parse parse)
         {
-            std::ostringstream ss;
-            encode(ss);
-            return ss.str();
+            state.stats = &stats;
+            const std::chrono::nanoseconds before = stats.readTime + stats.insertTime + stats.convertTime;
+            std::chrono::nanoseconds elapsed(0);
+            bool result;
+            {
+                IniStatsTimer timer(&elapsed);
+                result = parse();
+            }
+            // the extrapolated insert time can exceed the actual one
+            const std::chrono::nanoseconds other = stats.readTime + stats.insertTime + stats.convertTime - before;
+            if(elapsed > other)
+                stats.tokenizeTime += elapsed - other;
+            stats.lines += static_cast<std::size_t>(state.lineNo);
+            return result;
         }
+#endif
 
-        /** Saves this inifile object to the file at the given path.
-          * @param fileName path to the file where the data should be stored. */
-        void save(const std::string &fileName) const
+    public:
+        IniParser() = default;
+
+        IniParser(const char fieldSep, const std::vector<std::string> &commentPrefixes)
+            : fieldSep_(fieldSep), commentPrefixes_(commentPrefixes)
+        {}
+
+        /** Returns true if the character is trimmed from lines, names and values. */
+        static constexpr bool isWhitespace(const char c)
         {
-            std::ofstream os(fileName.c_str());
-            encode(os);
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
         }
-    };
 
-    using IniFile = IniFileBase<std::less<std::string>>;
-    using IniSection = IniSectionBase<std::less<std::string>>;
-    using IniFileCaseInsensitive = IniFileBase<StringInsensitiveLess>;
-    using IniSectionCaseInsensitive = IniSectionBase<StringInsensitiveLess>;
+        /** Writes the given string to the stream and escapes all comment
+          * prefixes. Newlines are written as multi-line value continuations if
+          * multi-line values are enabled. Runs of characters which need no
+          * escaping are written at once.
+          * @return number of characters written. */
+        std::size_t writeEscaped(std::ostream &os, const StringView str) const
+        {
+            std::size_t written = str.size();
+            const char *chunk = str.data();
+            const char *pos = str.data();
+            const char *const end = str.data() + str.size();
+            while(true)
+            {
+                pos = escapeScanner_.find(pos, end);
+                if(pos == end)
+                    break;
+
+                const std::string *prefix = commentMatcher_.match(pos, end);
+                if(prefix != nullptr)
+                {
+                    os.write(chunk, pos - chunk);
+                    os.put(esc_);
+                    os.write(prefix->data(), static_cast<std::streamsize>(prefix->size()));
+                    pos += prefix->size();
+                    chunk = pos;
+                    ++written;
+                }
+                else if(multiLineValues_ && *pos == '\n')
+                {
+                    os.write(chunk, pos - chunk);
+                    os.write("\n\t", 2);
+                    ++pos;
+                    chunk = pos;
+                    ++written;
+                }
+                else
+                {
+                    ++pos;
+                }
+            }
+            os.write(chunk, end - chunk);
+            return written;
+        }
+
+        /** Sets the separator character for fields. Default is '='. */
+        void setFieldSep(const char sep)
+        {
+            fieldSep_ = sep;
+            updateSyntax();
+        }
+
+        char fieldSep() const
+        {
+            return fieldSep_;
+        }
+
+        /** Sets the list of strings that start a comment.
+          * Default is [ "#", ";" ]. */
+        void setCommentPrefixes(const std::vector<std::string> &commentPrefixes)
+        {
+            commentPrefixes_ = commentPrefixes;
+            updateSyntax();
+        }
+
+        const std::vector<std::string> &commentPrefixes() const
+        {
+            return commentPrefixes_;
+        }
+
+        const CommentMatcher &commentMatcher() const
+        {
+            return commentMatcher_;
+        }
+
+        /** Sets the character that escapes comment prefixes. Default is '\'. */
+        void setEscapeChar(const char esc)
+        {
+            esc_ = esc;
+            updateSyntax();
+        }
+
+        char escapeChar() const
+        {
+            return esc_;
+        }
+
+        /** Sets whether indented lines continue the value of the previous
+          * field. Default is false. */
+        void setMultiLineValues(const bool enable)
+        {
+            multiLineValues_ = enable;
+        }
+
+        bool multiLineValues() const
+        {
+            return multiLineValues_;
+        }
+
+        /** Sets the instruction set used to scan the input.
+          * Falls back to ScanKernel::Scalar if the CPU does not support it. */
+        void setScanKernel(const ScanKernel kernel)
+        {
+            scanner_.setKernel(kernel);
+            escapeScanner_.setKernel(kernel);
+        }
+
+        ScanKernel scanKernel() const
+        {
+            return scanner_.kernel();
+        }
+
+        /** Parses the given character buffer and reports its contents to the
+          * handler. Only names and values which contain escape chars and
+          * multi-line values are copied into scratch memory.
+          * @param data pointer to the ini data to be parsed.
+          * @param size number of characters in the buffer.
+          * @param handler receiver of the parse events.
+          * @return true if the whole buffer was parsed, false if the handler
+          *         stopped the parser. */
+        template<typename Handler>
+        bool parse(const char *data, const std::size_t size, Handler &handler) const
+        {
+            ParseState state;
+            return parseBuffer(data, size, state, handler);
+        }
+
+        /** Parses the given string and reports its contents to the handler.
+          * @return true if the whole string was parsed, false if the handler
+          *         stopped the parser. */
+        template<typename Handler>
+        bool parse(const StringView content, Handler &handler) const
+        {
+            return parse(content.data(), content.size(), handler);
+        }
+
+        /** Parses the given stream block by block and reports its contents to
+          * the handler. Only the current block and the line which spans into
+          * the next one are kept in memory.
+          * @return true if the whole stream was parsed, false if the handler
+          *         stopped the parser. */
+        template<typename Handler>
+        bool parse(std::istream &is, Handler &handler) const
+        {
+            ParseState state;
+            return parseStream(is, state, handler);
+        }
+
+#ifdef INICPP_HAS_STATS
+        /** Parses the given character buffer like parse() and adds the
+          * parsed bytes, lines and multi-line continuations and the time
+          * spent tokenizing and unescaping to the given statistics. Time
+          * which the handler adds to the insert phase is not counted as
+          * tokenizing. */
+        template<typename Handler>
+        bool parse(const char *data, const std::size_t size, Handler &handler, IniStats &stats) const
+        {
+            ParseState state;
+            stats.bytes += size;
+            return parseObserved(state, stats, [&]() { return parseBuffer(data, size, state, handler); });
+        }
+
+        /** Parses the given stream like parse() and adds its statistics,
+          * including the time spent reading the stream. */
+        template<typename Handler>
+        bool parse(std::istream &is, Handler &handler, IniStats &stats) const
+        {
+            ParseState state;
+            return parseObserved(state, stats, [&]() { return parseStream(is, state, handler); });
+        }
+#endif
+    };
+
+#ifdef INICPP_HAS_THREADS
+    /************************************************
+     * Thread Pool
+     ************************************************/
+
+    /** Fixed set of worker threads which run the chunks of a parallel
+      * decode. The calling thread takes part in each run, so a pool of size
+      * n starts n - 1 workers. Runs of concurrent callers are serialized. */
+    class ThreadPool
+    {
+    private:
+        std::vector<std::thread> workers_;
+        // serializes concurrent calls of run()
+        std::mutex runMutex_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        const std::function<void(std::size_t)> *task_ = nullptr;
+        std::size_t next_ = 0;
+        std::size_t count_ = 0;
+        std::size_t unfinished_ = 0;
+        std::size_t generation_ = 0;
+        std::exception_ptr error_;
+        bool stop_ = false;
+
+        /** Runs tasks of the current generation until none are left. */
+        void work(std::unique_lock<std::mutex> &lock)
+        {
+            while(next_ < count_)
+            {
+                const std::size_t index = next_++;
+                lock.unlock();
+                std::exception_ptr error;
+                try
+                {
+                    (*task_)(index);
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                if(error && !error_)
+                    error_ = error;
+                if(--unfinished_ == 0)
+                    done_.notify_all();
+            }
+        }
+
+        void workerLoop()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            std::size_t generation = generation_;
+            while(true)
+            {
+                wake_.wait(lock, [&]() { return stop_ || generation != generation_; });
+                if(stop_)
+                    return;
+                generation = generation_;
+                work(lock);
+            }
+        }
+
+    public:
+        /** Creates a pool which runs up to the given number of tasks at once.
+          * @param threads number of threads including the calling thread,
+          *        defaults to the number of hardware threads. */
+        explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency())
+        {
+            if(threads == 0)
+                threads = 1;
+            workers_.reserve(threads - 1);
+            for(std::size_t i = 1; i < threads; ++i)
+                workers_.emplace_back([this]() { workerLoop(); });
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for(std::thread &worker : workers_)
+                worker.join();
+        }
+
+        /** Returns the number of threads which run tasks at once. */
+        std::size_t size() const
+        {
+            return workers_.size() + 1;
+        }
+
+        /** Calls task(i) for each i in [0, count) and returns once all calls
+          * are finished. If a call throws, the first exception is rethrown
+          * after all calls are finished. */
+        void run(const std::size_t count, const std::function<void(std::size_t)> &task)
+        {
+            std::lock_guard<std::mutex> runLock(runMutex_);
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_ = &task;
+            next_ = 0;
+            count_ = count;
+            unfinished_ = count;
+            error_ = nullptr;
+            ++generation_;
+            wake_.notify_all();
+
+            work(lock);
+            done_.wait(lock, [&]() { return unfinished_ == 0; });
+            task_ = nullptr;
+            count_ = 0;
+            if(error_)
+            {
+                std::exception_ptr error = error_;
+                error_ = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+    };
+#endif
+
+    /************************************************
+     * Conversion Functors
+     ************************************************/
+
+    /** Result of parsing a number from a character range. */
+    enum class ParseResult
+    {
+        Ok,
+        // the range does not contain a valid number
+        Invalid,
+        // the number cannot be represented by the result type
+        OutOfRange
+    };
+
+    /** Returns the value of the given digit character or a value greater than
+      * or equal to 36 if it is not a digit. */
+    inline unsigned int digitValue(const char c)
+    {
+        const unsigned int digit = static_cast<unsigned int>(static_cast<unsigned char>(c) - '0');
+        if(digit < 10)
+            return digit;
+        const unsigned int letter = static_cast<unsigned int>(static_cast<unsigned char>(c | 0x20) - 'a');
+        return letter < 26 ? letter + 10 : 36;
+    }
+
+    /** Parses the unsigned digits in [begin, end) with the given base.
+      * The whole range has to consist of digits. */
+    template<typename U>
+    inline ParseResult parseDigits(const char *begin, const char *end, const unsigned int base, U &result)
+    {
+        if(begin == end)
+            return ParseResult::Invalid;
+
+#ifdef INICPP_HAS_CHARCONV
+        const std::from_chars_result res = std::from_chars(begin, end, result, static_cast<int>(base));
+        if(res.ec == std::errc::result_out_of_range)
+            return res.ptr == end ? ParseResult::OutOfRange : ParseResult::Invalid;
+        if(res.ec != std::errc() || res.ptr != end)
+            return ParseResult::Invalid;
+        return ParseResult::Ok;
+#else
+        const U maxValue = std::numeric_limits<U>::max();
+        const U maxPrefix = maxValue / base;
+        const unsigned int maxDigit = static_cast<unsigned int>(maxValue % base);
+        U value = 0;
+        bool overflow = false;
+        for(; begin != end; ++begin)
+        {
+            const unsigned int digit = digitValue(*begin);
+            if(digit >= base)
+                return ParseResult::Invalid;
+            if(value > maxPrefix || (value == maxPrefix && digit > maxDigit))
+                overflow = true;
+            value = static_cast<U>(value * base + digit);
+        }
+        if(overflow)
+            return ParseResult::OutOfRange;
+        result = value;
+        return ParseResult::Ok;
+#endif
+    }
+
+    /** Parses an integer from the character range [begin, end) in a single
+      * pass without allocating. The range may start with a sign. The base is
+      * determined by the prefix: "0x" for hexadecimal, "0b" for binary, a
+      * leading "0" for octal and decimal otherwise.
+      * Values which cannot be represented by T are reported as OutOfRange
+      * instead of being truncated. */
+    template<typename T>
+    inline ParseResult parseInteger(const char *begin, const char *end, T &result)
+    {
+        static_assert(std::is_integral<T>::value, "parseInteger requires an integral type");
+        using U = typename std::make_unsigned<T>::type;
+
+        bool negative = false;
+        if(begin != end && (*begin == '-' || *begin == '+'))
+        {
+            negative = *begin == '-';
+            ++begin;
+        }
+
+        unsigned int base = 10;
+        if(end - begin >= 2 && begin[0] == '0')
+        {
+            const char c = static_cast<char>(begin[1] | 0x20);
+            if(c == 'x')
+            {
+                base = 16;
+                begin += 2;
+            }
+            else if(c == 'b')
+            {
+                base = 2;
+                begin += 2;
+            }
+            else
+            {
+                base = 8;
+                begin += 1;
+            }
+        }
+
+        U magnitude = 0;
+        const ParseResult res = parseDigits(begin, end, base, magnitude);
+        if(res != ParseResult::Ok)
+            return res;
+
+        const U maxValue = static_cast<U>(std::numeric_limits<T>::max());
+        if(!negative)
+        {
+            if(magnitude > maxValue)
+                return ParseResult::OutOfRange;
+            result = static_cast<T>(magnitude);
+        }
+        else if(magnitude == 0)
+        {
+            result = 0;
+        }
+        else
+        {
+            // the magnitude of the minimum of a signed type is max + 1
+            if(!std::is_signed<T>::value || magnitude - 1 > maxValue)
+                return ParseResult::OutOfRange;
+            result = static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
+        }
+        return ParseResult::Ok;
+    }
+
+    /** Throws if the given parse result is not ParseResult::Ok.
+      * @param typeName name of the parsed type used in the error message */
+    inline void checkParseResult(const ParseResult result, const char *typeName)
+    {
+        switch(result)
+        {
+        case ParseResult::Ok:
+            break;
+        case ParseResult::Invalid:
+            throw std::invalid_argument(std::string("field is not ") + typeName);
+        case ParseResult::OutOfRange:
+            throw std::out_of_range(std::string("field is out of range of ") + typeName);
+        }
+    }
+
+    /** Parses an integer from the character range [begin, end) and throws if
+      * the range is not a valid integer or out of the range of T.
+      * @param typeName name of T used in the error message */
+    template<typename T>
+    inline void decodeInteger(const char *begin, const char *end, T &result, const char *typeName)
+    {
+        checkParseResult(parseInteger(begin, end, result), typeName);
+    }
+
+    /** Returns a table of the two digit decimal numbers "00" to "99". */
+    inline const char *digitPairs()
+    {
+        return "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+               "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+    }
+
+    template<typename T>
+    inline bool isNegative(const T value, std::true_type)
+    {
+        return value < 0;
+    }
+
+    template<typename T>
+    inline bool isNegative(const T, std::false_type)
+    {
+        return false;
+    }
+
+    /** Maximum number of characters formatInteger() writes for type T. */
+    template<typename T>
+    constexpr std::size_t maxIntegerChars()
+    {
+        return std::numeric_limits<T>::digits10 + 2;
+    }
+
+    /** Writes the decimal representation of the given integer to the buffer
+      * starting at first without allocating and returns the end of the
+      * written characters. The buffer has to hold at least
+      * maxIntegerChars<T>() characters.
+      * Uses std::to_chars if available and otherwise writes two digits at a
+      * time from a lookup table. */
+    template<typename T>
+    inline char *formatInteger(char *first, char *last, const T value)
+    {
+        static_assert(std::is_integral<T>::value, "formatInteger requires an integral type");
+        assert(static_cast<std::size_t>(last - first) >= maxIntegerChars<T>());
+#ifdef INICPP_HAS_CHARCONV
+        return std::to_chars(first, last, value).ptr;
+#else
+        (void)last;
+        using U = typename std::make_unsigned<T>::type;
+        const bool negative = isNegative(value, std::is_signed<T>());
+        U magnitude = negative ? static_cast<U>(U(0) - static_cast<U>(value)) : static_cast<U>(value);
+
+        char buf[maxIntegerChars<T>()];
+        char *pos = buf + sizeof(buf);
+        const char *pairs = digitPairs();
+        while(magnitude >= 100)
+        {
+            const std::size_t idx = static_cast<std::size_t>(magnitude % 100) * 2;
+            magnitude = static_cast<U>(magnitude / 100);
+            *--pos = pairs[idx + 1];
+            *--pos = pairs[idx];
+        }
+        if(magnitude >= 10)
+        {
+            const std::size_t idx = static_cast<std::size_t>(magnitude) * 2;
+            *--pos = pairs[idx + 1];
+            *--pos = pairs[idx];
+        }
+        else
+        {
+            *--pos = static_cast<char>('0' + magnitude);
+        }
+        if(negative)
+            *--pos = '-';
+
+        const std::size_t size = static_cast<std::size_t>(buf + sizeof(buf) - pos);
+        std::memcpy(first, pos, size);
+        return first + size;
+#endif
+    }
+
+    /** Replaces the content of result with the decimal representation of the
+      * given integer. The existing buffer of result is reused, so no memory
+      * is allocated if it is large enough. */
+    template<typename T>
+    inline void encodeInteger(const T value, std::string &result)
+    {
+        char buf[maxIntegerChars<T>()];
+        const char *end = formatInteger(buf, buf + sizeof(buf), value);
+        result.assign(buf, static_cast<std::size_t>(end - buf));
+    }
+
+    /** Maximum number of characters formatFloatingPoint() writes. */
+    constexpr std::size_t maxFloatingPointChars()
+    {
+        return 32;
+    }
+
+    /** Checks if [begin, end) is a decimal floating point number, infinity or
+      * NaN in the format written by formatFloatingPoint(), optionally
+      * preceded by a sign. */
+    inline bool isFloatingPointSyntax(const char *begin, const char *end)
+    {
+        if(begin != end && (*begin == '-' || *begin == '+'))
+            ++begin;
+
+        const std::size_t len = static_cast<std::size_t>(end - begin);
+        for(const char *word : {"inf", "infinity", "nan"})
+        {
+            if(std::strlen(word) != len)
+                continue;
+            std::size_t i = 0;
+            while(i < len && (begin[i] | 0x20) == word[i])
+                ++i;
+            if(i == len)
+                return true;
+        }
+
+        std::size_t digits = 0;
+        for(; begin != end && static_cast<unsigned char>(*begin - '0') < 10; ++begin)
+            ++digits;
+        if(begin != end && *begin == '.')
+        {
+            for(++begin; begin != end && static_cast<unsigned char>(*begin - '0') < 10; ++begin)
+                ++digits;
+        }
+        if(digits == 0)
+            return false;
+
+        if(begin != end && (*begin | 0x20) == 'e')
+        {
+            ++begin;
+            if(begin != end && (*begin == '-' || *begin == '+'))
+                ++begin;
+            if(begin == end)
+                return false;
+            for(; begin != end && static_cast<unsigned char>(*begin - '0') < 10; ++begin)
+            {}
+        }
+
+        return begin == end;
+    }
+
+    /** Replaces the first occurrence of the given decimal point in [first, end)
+      * by '.' and returns the new end of the range. */
+    inline char *delocalizeDecimalPoint(char *first, char *end, const char *point)
+    {
+        const std::size_t pointLen = std::strlen(point);
+        if(pointLen == 0 || (pointLen == 1 && point[0] == '.'))
+            return end;
+
+        char *pos = std::search(first, end, point, point + pointLen);
+        if(pos == end)
+            return end;
+        *pos = '.';
+        std::memmove(pos + 1, pos + pointLen, static_cast<std::size_t>(end - pos) - pointLen);
+        return end - (pointLen - 1);
+    }
+
+    inline double strToFloatingPoint(const char *str, char **end, double)
+    {
+        return std::strtod(str, end);
+    }
+
+    inline float strToFloatingPoint(const char *str, char **end, float)
+    {
+        return std::strtof(str, end);
+    }
+
+    /** Parses a floating point number from the character range [begin, end)
+      * independent of the current locale. The range may start with a sign.
+      * Uses std::from_chars if available. Otherwise the number is validated
+      * and converted with strtod after replacing the '.' by the decimal point
+      * of the C locale, which only allocates for numbers with more than 64
+      * characters. */
+    template<typename T>
+    inline ParseResult parseFloatingPoint(const char *begin, const char *end, T &result)
+    {
+        static_assert(std::is_floating_point<T>::value, "parseFloatingPoint requires a floating point type");
+#ifdef INICPP_HAS_FLOAT_CHARCONV
+        if(begin != end && *begin == '+')
+        {
+            ++begin;
+            if(begin != end && (*begin == '-' || *begin == '+'))
+                return ParseResult::Invalid;
+        }
+        const std::from_chars_result res = std::from_chars(begin, end, result);
+        if(res.ec == std::errc::result_out_of_range)
+            return res.ptr == end ? ParseResult::OutOfRange : ParseResult::Invalid;
+        if(res.ec != std::errc() || res.ptr != end)
+            return ParseResult::Invalid;
+        return ParseResult::Ok;
+#else
+        if(!isFloatingPointSyntax(begin, end))
+            return ParseResult::Invalid;
+
+        const char *point = std::localeconv()->decimal_point;
+        const std::size_t pointLen = std::strlen(point);
+        const std::size_t len = static_cast<std::size_t>(end - begin);
+        char stackBuf[64];
+        std::string heapBuf;
+        char *buf = stackBuf;
+        if(len + pointLen + 1 > sizeof(stackBuf))
+        {
+            heapBuf.resize(len + pointLen + 1);
+            buf = &heapBuf[0];
+        }
+
+        char *bufEnd = buf;
+        for(; begin != end; ++begin)
+        {
+            if(*begin == '.')
+            {
+                std::memcpy(bufEnd, point, pointLen);
+                bufEnd += pointLen;
+            }
+            else
+            {
+                *bufEnd++ = *begin;
+            }
+        }
+        *bufEnd = '\0';
+
+        errno = 0;
+        char *parsedEnd;
+        const T value = strToFloatingPoint(buf, &parsedEnd, T());
+        if(parsedEnd != bufEnd)
+            return ParseResult::Invalid;
+        if(errno == ERANGE && (value == 0 || std::isinf(value)))
+            return ParseResult::OutOfRange;
+        result = value;
+        return ParseResult::Ok;
+#endif
+    }
+
+    /** Writes the shortest decimal representation of the given floating point
+      * number, which parses back to exactly the same value, to the buffer
+      * starting at first and returns the end of the written characters. The
+      * output does not depend on the current locale. The buffer has to hold
+      * at least maxFloatingPointChars() characters.
+      * Uses std::to_chars if available. Otherwise the precision is increased
+      * until the number written by snprintf round-trips. */
+    template<typename T>
+    inline char *formatFloatingPoint(char *first, char *last, const T value)
+    {
+        static_assert(std::is_floating_point<T>::value, "formatFloatingPoint requires a floating point type");
+        assert(static_cast<std::size_t>(last - first) >= maxFloatingPointChars());
+#ifdef INICPP_HAS_FLOAT_CHARCONV
+        return std::to_chars(first, last, value).ptr;
+#else
+        const char *point = std::localeconv()->decimal_point;
+        char *end = first;
+        // all numbers with at most digits10 significant digits round-trip,
+        // trailing zeros are removed by %g
+        for(int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+        {
+            const int size = std::snprintf(first, static_cast<std::size_t>(last - first), "%.*g", precision, static_cast<double>(value));
+            end = delocalizeDecimalPoint(first, first + size, point);
+
+            T parsed;
+            if(std::isnan(value) || (parseFloatingPoint(first, end, parsed) == ParseResult::Ok && parsed == value))
+                break;
+        }
+        return end;
+#endif
+    }
+
+    /** Replaces the content of result with the shortest round-trip decimal
+      * representation of the given floating point number. The existing
+      * buffer of result is reused. */
+    template<typename T>
+    inline void encodeFloatingPoint(const T value, std::string &result)
+    {
+        char buf[maxFloatingPointChars()];
+        const char *end = formatFloatingPoint(buf, buf + sizeof(buf), value);
+        result.assign(buf, static_cast<std::size_t>(end - buf));
+    }
+
+    inline bool strToLong(const std::string &value, long &result)
+    {
+        return parseInteger(value.data(), value.data() + value.size(), result) == ParseResult::Ok;
+    }
+
+    inline bool strToULong(const std::string &value, unsigned long &result)
+    {
+        return parseInteger(value.data(), value.data() + value.size(), result) == ParseResult::Ok;
+    }
+
+    template<typename T>
+    struct Convert
+    {};
+
+    template<>
+    struct Convert<bool>
+    {
+        void decode(const std::string &value, bool &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, bool &result)
+        {
+            if(equalsLetters(value, size, "true"))
+                result = true;
+            else if(equalsLetters(value, size, "false"))
+                result = false;
+            else
+                throw std::invalid_argument("field is not a bool");
+        }
+
+    private:
+        /** Compares the given range to the lower case letters in word ignoring
+          * the case of the range. */
+        static bool equalsLetters(const char *value, const size_t size, const char *word)
+        {
+            size_t i = 0;
+            while(i < size && word[i] != '\0' && (value[i] | 0x20) == word[i])
+                ++i;
+            return i == size && word[i] == '\0';
+        }
+
+    public:
+
+        void encode(const bool value, std::string &result)
+        {
+            result = value ? "true" : "false";
+        }
+    };
+
+    template<>
+    struct Convert<char>
+    {
+        void decode(const std::string &value, char &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, char &result)
+        {
+            assert(size > 0);
+            (void)size;
+            result = static_cast<char>(value[0]);
+        }
+
+        void encode(const char value, std::string &result)
+        {
+            result = value;
+        }
+    };
+
+    template<>
+    struct Convert<unsigned char>
+    {
+        void decode(const std::string &value, unsigned char &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, unsigned char &result)
+        {
+            assert(size > 0);
+            (void)size;
+            result = static_cast<unsigned char>(value[0]);
+        }
+
+        void encode(const unsigned char value, std::string &result)
+        {
+            result = value;
+        }
+    };
+
+    template<>
+    struct Convert<short>
+    {
+        void decode(const std::string &value, short &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, short &result)
+        {
+            decodeInteger(value, value + size, result, "a short");
+        }
+
+        void encode(const short value, std::string &result)
+        {
+            encodeInteger(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<unsigned short>
+    {
+        void decode(const std::string &value, unsigned short &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, unsigned short &result)
+        {
+            decodeInteger(value, value + size, result, "an unsigned short");
+        }
+
+        void encode(const unsigned short value, std::string &result)
+        {
+            encodeInteger(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<int>
+    {
+        void decode(const std::string &value, int &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, int &result)
+        {
+            decodeInteger(value, value + size, result, "an int");
+        }
+
+        void encode(const int value, std::string &result)
+        {
+            encodeInteger(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<unsigned int>
+    {
+        void decode(const std::string &value, unsigned int &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, unsigned int &result)
+        {
+            decodeInteger(value, value + size, result, "an unsigned int");
+        }
+
+        void encode(const unsigned int value, std::string &result)
+        {
+            encodeInteger(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<long>
+    {
+        void decode(const std::string &value, long &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, long &result)
+        {
+            decodeInteger(value, value + size, result, "a long");
+        }
+
+        void encode(const long value, std::string &result)
+        {
+            encodeInteger(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<unsigned long>
+    {
+        void decode(const std::string &value, unsigned long &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, unsigned long &result)
+        {
+            decodeInteger(value, value + size, result, "an unsigned long");
+        }
+
+        void encode(const unsigned long value, std::string &result)
+        {
+            encodeInteger(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<double>
+    {
+        void decode(const std::string &value, double &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, double &result)
+        {
+            checkParseResult(parseFloatingPoint(value, value + size, result), "a double");
+        }
+
+        void encode(const double value, std::string &result)
+        {
+            encodeFloatingPoint(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<float>
+    {
+        void decode(const std::string &value, float &result)
+        {
+            decode(value.data(), value.size(), result);
+        }
+
+        void decode(const char *value, const size_t size, float &result)
+        {
+            checkParseResult(parseFloatingPoint(value, value + size, result), "a float");
+        }
+
+        void encode(const float value, std::string &result)
+        {
+            encodeFloatingPoint(value, result);
+        }
+    };
+
+    template<>
+    struct Convert<std::string>
+    {
+        void decode(const std::string &value, std::string &result)
+        {
+            result = value;
+        }
+
+        void decode(const char *value, const size_t size, std::string &result)
+        {
+            result.assign(value, size);
+        }
+
+        void encode(const std::string &value, std::string &result)
+        {
+            result = value;
+        }
+    };
+
+#ifdef __cpp_lib_string_view
+    template<>
+    struct Convert<std::string_view>
+    {
+        void decode(const std::string &value, std::string_view &result)
+        {
+            result = value;
+        }
+
+        void decode(const char *value, const size_t size, std::string_view &result)
+        {
+            result = std::string_view(value, size);
+        }
+
+        void encode(const std::string_view value, std::string &result)
+        {
+            result = value;
+        }
+    };
+#endif
+
+    template<>
+    struct Convert<const char*>
+    {
+        void encode(const char* const &value, std::string &result)
+        {
+            result = value;
+        }
+
+        void decode(const std::string &value, const char* &result)
+        {
+            result = value.c_str();
+        }
+
+        /** The range has to be followed by a null character. */
+        void decode(const char *value, const size_t, const char* &result)
+        {
+            result = value;
+        }
+    };
+
+    template<>
+    struct Convert<char*>
+    {
+        void encode(const char* const &value, std::string &result)
+        {
+            result = value;
+        }
+    };
+
+    template<size_t n>
+    struct Convert<char[n]>
+    {
+        void encode(const char *value, std::string &result)
+        {
+            result = value;
+        }
+    };
+
+    /** Identifies the types whose decoded values are cached by IniField.
+      * Types with tag 0 are decoded on every access. */
+    template<typename T>
+    struct CacheTag : std::integral_constant<unsigned int, 0>
+    {};
+
+    template<> struct CacheTag<bool> : std::integral_constant<unsigned int, 1> {};
+    template<> struct CacheTag<char> : std::integral_constant<unsigned int, 2> {};
+    template<> struct CacheTag<unsigned char> : std::integral_constant<unsigned int, 3> {};
+    template<> struct CacheTag<short> : std::integral_constant<unsigned int, 4> {};
+    template<> struct CacheTag<unsigned short> : std::integral_constant<unsigned int, 5> {};
+    template<> struct CacheTag<int> : std::integral_constant<unsigned int, 6> {};
+    template<> struct CacheTag<unsigned int> : std::integral_constant<unsigned int, 7> {};
+    template<> struct CacheTag<long> : std::integral_constant<unsigned int, 8> {};
+    template<> struct CacheTag<unsigned long> : std::integral_constant<unsigned int, 9> {};
+    template<> struct CacheTag<float> : std::integral_constant<unsigned int, 10> {};
+    template<> struct CacheTag<double> : std::integral_constant<unsigned int, 11> {};
+
+#ifndef INICPP_NO_VALUE_CACHE
+    /** Holds the last value decoded from a field for one of the arithmetic
+      * types with a CacheTag. The slot can be read and filled concurrently
+      * from multiple threads. It is guarded by a sequence lock: the state
+      * holds the tag of the cached type in its low byte, a busy bit while a
+      * value is written and a sequence number which changes on every write.
+      * Readers only use the value if the state did not change while they
+      * read it, so a cache hit costs two loads of the state and one of the
+      * value. */
+    class ValueCache
+    {
+    private:
+        static constexpr std::uint64_t TagMask = 0xFF;
+        static constexpr std::uint64_t BusyBit = 0x100;
+        static constexpr std::uint64_t SequenceStep = 0x200;
+
+        mutable std::atomic<std::uint64_t> state_;
+        mutable std::atomic<std::uint64_t> bits_;
+
+    public:
+        ValueCache() : state_(0), bits_(0)
+        {}
+
+        ValueCache(const ValueCache &) : state_(0), bits_(0)
+        {}
+
+        ValueCache &operator=(const ValueCache &)
+        {
+            clear();
+            return *this;
+        }
+
+        /** Reads the cached value of type T. Returns false if no value of
+          * this type is cached. */
+        template<typename T>
+        bool load(T &result) const
+        {
+            static_assert(sizeof(T) <= sizeof(std::uint64_t), "cached type is too large");
+            const std::uint64_t state = state_.load(std::memory_order_acquire);
+            if((state & (TagMask | BusyBit)) != CacheTag<T>::value)
+                return false;
+
+            const std::uint64_t bits = bits_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(state_.load(std::memory_order_relaxed) != state)
+                return false;
+
+            std::memcpy(&result, &bits, sizeof(T));
+            return true;
+        }
+
+        /** Caches the given value. If another thread is writing the cache at
+          * the same time, the value is dropped. */
+        template<typename T>
+        void store(const T &value) const
+        {
+            std::uint64_t state = state_.load(std::memory_order_relaxed);
+            if((state & BusyBit) != 0 ||
+                !state_.compare_exchange_strong(state, state | BusyBit, std::memory_order_acquire))
+                return;
+            // orders the busy state before the new bits: a reader whose
+            // acquire fence observes these bits also observes the busy state
+            // when it reads the state again, so it drops the value
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(T));
+            bits_.store(bits, std::memory_order_relaxed);
+            const std::uint64_t sequence = (state & ~(TagMask | BusyBit)) + SequenceStep;
+            state_.store(sequence | CacheTag<T>::value, std::memory_order_release);
+        }
+
+        /** Drops the cached value. Must not be called concurrently with
+          * load() or store(). */
+        void clear()
+        {
+            state_.store(0, std::memory_order_relaxed);
+        }
+    };
+#endif
+
+    template<typename T>
+    struct VoidType
+    {
+        using type = void;
+    };
+
+    /** Determines if Convert<T> can decode a value from a character range. */
+    template<typename T, typename = void>
+    struct HasRangeDecode : std::false_type
+    {};
+
+    template<typename T>
+    struct HasRangeDecode<T, typename VoidType<decltype(std::declval<Convert<T> &>().decode(
+        std::declval<const char *>(), std::declval<size_t>(), std::declval<T &>()))>::type> : std::true_type
+    {};
+
+    template<typename T>
+    T convertRange(const char *value, const std::size_t size, std::true_type)
+    {
+        T result = T();
+        Convert<T> conv;
+        conv.decode(value, size, result);
+        return result;
+    }
+
+    template<typename T>
+    T convertRange(const char *value, const std::size_t size, std::false_type)
+    {
+        T result = T();
+        Convert<T> conv;
+        conv.decode(std::string(value, size), result);
+        return result;
+    }
+
+    /** Converts the given character range to T using Convert<T>. */
+    template<typename T>
+    T convertRange(const char *value, const std::size_t size)
+    {
+        return convertRange<T>(value, size, HasRangeDecode<T>());
+    }
+
+    template<typename Comparator, typename Storage, typename Allocator>
+    class IniFileBase;
+
+    /** Value of a field in an ini file. The value is stored as string and
+      * converted to other types by Convert<T>. The memory of the string is
+      * obtained from the given allocator. */
+    template<typename Allocator = std::allocator<char>>
+    class IniFieldBase
+    {
+    public:
+        using allocator_type = Allocator;
+        using string_type = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+    private:
+        template<typename Comparator, typename Storage, typename Alloc>
+        friend class IniFileBase;
+
+        string_type value_;
+#ifndef INICPP_NO_VALUE_CACHE
+        ValueCache cache_;
+#endif
+
+        template<typename T>
+        static void decodeValue(const std::string &value, T &result)
+        {
+            Convert<T> conv;
+            conv.decode(value, result);
+        }
+
+        template<typename T, typename String>
+        static void decodeValue(const String &value, T &result)
+        {
+            decodeRange(value, result, HasRangeDecode<T>());
+        }
+
+        template<typename T, typename String>
+        static void decodeRange(const String &value, T &result, std::true_type)
+        {
+            Convert<T> conv;
+            conv.decode(value.data(), value.size(), result);
+        }
+
+        template<typename T, typename String>
+        static void decodeRange(const String &value, T &result, std::false_type)
+        {
+            Convert<T> conv;
+            conv.decode(std::string(value.data(), value.size()), result);
+        }
+
+        template<typename T>
+        static void encodeValue(const T &value, std::string &result)
+        {
+            Convert<T> conv;
+            conv.encode(value, result);
+        }
+
+        /** Encodes into a per thread buffer first, because Convert<T> only
+          * writes to std::string. */
+        template<typename T, typename String>
+        static void encodeValue(const T &value, String &result)
+        {
+            static thread_local std::string buffer;
+            Convert<T> conv;
+            conv.encode(value, buffer);
+            result.assign(buffer.data(), buffer.size());
+        }
+
+        template<typename T>
+        T decode(std::false_type) const
+        {
+            T result = T();
+            decodeValue(value_, result);
+            return result;
+        }
+
+        template<typename T>
+        T decode(std::true_type) const
+        {
+#ifdef INICPP_NO_VALUE_CACHE
+            return decode<T>(std::false_type());
+#else
+            T result = T();
+            if(!cache_.load(result))
+            {
+                result = decode<T>(std::false_type());
+                cache_.store(result);
+            }
+            return result;
+#endif
+        }
+
+        void invalidate()
+        {
+#ifndef INICPP_NO_VALUE_CACHE
+            cache_.clear();
+#endif
+        }
+
+        /** Grants write access to the raw value for decoding. */
+        string_type &buffer()
+        {
+            invalidate();
+            return value_;
+        }
+
+    public:
+        IniFieldBase() : value_()
+        {}
+
+        explicit IniFieldBase(const allocator_type &alloc) : value_(alloc)
+        {}
+
+        IniFieldBase(const std::string &value, const allocator_type &alloc = allocator_type())
+            : value_(value.data(), value.size(), alloc)
+        {}
+
+        IniFieldBase(const char *value, const allocator_type &alloc = allocator_type()) : value_(value, alloc)
+        {}
+
+        IniFieldBase(string_type &&value) : value_(std::move(value))
+        {}
+
+        IniFieldBase(const IniFieldBase &field) : value_(field.value_)
+        {}
+
+        IniFieldBase(const IniFieldBase &field, const allocator_type &alloc) : value_(field.value_, alloc)
+        {}
+
+        IniFieldBase(IniFieldBase &&field) noexcept : value_(std::move(field.value_))
+        {
+            field.invalidate();
+        }
+
+        IniFieldBase(IniFieldBase &&field, const allocator_type &alloc) : value_(std::move(field.value_), alloc)
+        {
+            field.invalidate();
+        }
+
+        ~IniFieldBase()
+        {}
+
+        allocator_type get_allocator() const
+        {
+            return value_.get_allocator();
+        }
+
+        /** Returns the raw value of this field without converting it. */
+        const string_type &str() const
+        {
+            return value_;
+        }
+
+        /** Converts the value of this field to T. The result is cached for
+          * the arithmetic types, so repeated calls with the same type do not
+          * parse the value again until the field is assigned. Define
+          * INICPP_NO_VALUE_CACHE to disable the cache. */
+        template<typename T>
+        T as() const
+        {
+            return decode<T>(std::integral_constant<bool, CacheTag<T>::value != 0>());
+        }
+
+        template<typename T>
+        IniFieldBase &operator=(const T &value)
+        {
+            encodeValue(value, value_);
+            invalidate();
+            return *this;
+        }
+
+        /** Takes over the given string as value without copying it. */
+        IniFieldBase &operator=(string_type &&value)
+        {
+            value_ = std::move(value);
+            invalidate();
+            return *this;
+        }
+
+        IniFieldBase &operator=(const IniFieldBase &field)
+        {
+            value_ = field.value_;
+            invalidate();
+            return *this;
+        }
+
+        /** Moving the value may allocate if the allocator is not propagated,
+          * like std::pmr::polymorphic_allocator of different resources. */
+        IniFieldBase &operator=(IniFieldBase &&field) noexcept(std::is_nothrow_move_assignable<string_type>::value)
+        {
+            value_ = std::move(field.value_);
+            invalidate();
+            field.invalidate();
+            return *this;
+        }
+    };
+
+    using IniField = IniFieldBase<>;
+
+    /** Returns the ASCII lower case version of the given character.
+      * All other characters are returned unchanged. */
+    inline unsigned char toLowerAscii(const unsigned char c)
+    {
+        return static_cast<unsigned char>(c - 'A') < 26 ? static_cast<unsigned char>(c | 0x20) : c;
+    }
+
+    /** Converts all ASCII upper case characters in the given block of eight
+      * characters to lower case at once. */
+    inline std::uint64_t toLowerAscii(const std::uint64_t block)
+    {
+        const std::uint64_t highBits = 0x8080808080808080ULL;
+        const std::uint64_t lowBits = block & ~highBits;
+        // the high bit of each byte is set if the character is >= 'A' and
+        // > 'Z' respectively, the additions cannot overflow into the next byte
+        const std::uint64_t geA = lowBits + 0x3F3F3F3F3F3F3F3FULL;
+        const std::uint64_t gtZ = lowBits + 0x2525252525252525ULL;
+        const std::uint64_t upper = geA & ~gtZ & ~block & highBits;
+        return block | (upper >> 2);
+    }
+
+    /** Compares the given character ranges lexicographically ignoring the case
+      * of ASCII characters. Returns a negative value, zero or a positive value
+      * if lhs is less than, equal to or greater than rhs.
+      * The ranges are compared in blocks of eight characters without
+      * allocating any memory. */
+    inline int compareInsensitive(const char *lhs, const std::size_t lhsSize, const char *rhs, const std::size_t rhsSize)
+    {
+        const std::size_t size = std::min(lhsSize, rhsSize);
+        std::size_t i = 0;
+        for(; i + 8 <= size; i += 8)
+        {
+            std::uint64_t lhsBlock;
+            std::uint64_t rhsBlock;
+            std::memcpy(&lhsBlock, lhs + i, 8);
+            std::memcpy(&rhsBlock, rhs + i, 8);
+            if(lhsBlock != rhsBlock && toLowerAscii(lhsBlock) != toLowerAscii(rhsBlock))
+                break;
+        }
+
+        for(; i < size; ++i)
+        {
+            const unsigned char lhsChar = toLowerAscii(static_cast<unsigned char>(lhs[i]));
+            const unsigned char rhsChar = toLowerAscii(static_cast<unsigned char>(rhs[i]));
+            if(lhsChar != rhsChar)
+                return lhsChar < rhsChar ? -1 : 1;
+        }
+
+        if(lhsSize == rhsSize)
+            return 0;
+        return lhsSize < rhsSize ? -1 : 1;
+    }
+
+    /** Hashes the given character range to 64 bits. If insensitive is true,
+      * the case of ASCII characters is ignored. Blocks of eight characters are
+      * processed at once. The hash is not cryptographic. */
+    inline std::uint64_t hashBytes(const char *str, const std::size_t size, const bool insensitive)
+    {
+        // FNV-1a style hash which mixes in whole blocks
+        std::uint64_t result = 14695981039346656037ULL;
+        std::size_t i = 0;
+        for(; i + 8 <= size; i += 8)
+        {
+            std::uint64_t block;
+            std::memcpy(&block, str + i, 8);
+            result ^= insensitive ? toLowerAscii(block) : block;
+            result *= 1099511628211ULL;
+            result ^= result >> 32;
+        }
+        for(; i < size; ++i)
+        {
+            const unsigned char c = static_cast<unsigned char>(str[i]);
+            result ^= insensitive ? toLowerAscii(c) : c;
+            result *= 1099511628211ULL;
+        }
+        return result;
+    }
+
+    /** Hashes the given character range. If insensitive is true, the case of
+      * ASCII characters is ignored. */
+    inline std::size_t hashString(const char *str, const std::size_t size, const bool insensitive)
+    {
+        return static_cast<std::size_t>(hashBytes(str, size, insensitive));
+    }
+
+    /** Transparent comparator which orders strings lexicographically.
+      * Keys can be looked up by std::string, string literals or string views
+      * without building a temporary std::string. */
+    struct StringLess
+    {
+        using is_transparent = void;
+
+        bool operator()(const StringView lhs, const StringView rhs) const
+        {
+            return lhs.compare(rhs) < 0;
+        }
+    };
+
+    /** Transparent hash functor compatible with StringLess. */
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(const StringView str) const
+        {
+            return hashString(str.data(), str.size(), false);
+        }
+    };
+
+    /** Transparent equality functor compatible with StringLess. */
+    struct StringEqual
+    {
+        using is_transparent = void;
+
+        bool operator()(const StringView lhs, const StringView rhs) const
+        {
+            return lhs == rhs;
+        }
+    };
+
+    /** Transparent comparator which orders strings lexicographically ignoring
+      * the case of ASCII characters. The strings are compared in place without
+      * allocating. */
+    struct StringInsensitiveLess
+    {
+        using is_transparent = void;
+
+        bool operator()(const StringView lhs, const StringView rhs) const
+        {
+            return compareInsensitive(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+        }
+    };
+
+    /** Transparent hash functor which ignores the case of ASCII characters.
+      * Compatible with StringInsensitiveLess. */
+    struct StringInsensitiveHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(const StringView str) const
+        {
+            return hashString(str.data(), str.size(), true);
+        }
+    };
+
+    /** Transparent equality functor which ignores the case of ASCII characters.
+      * Compatible with StringInsensitiveLess. */
+    struct StringInsensitiveEqual
+    {
+        using is_transparent = void;
+
+        bool operator()(const StringView lhs, const StringView rhs) const
+        {
+            return lhs.size() == rhs.size() && compareInsensitive(lhs.data(), lhs.size(), rhs.data(), rhs.size()) == 0;
+        }
+    };
+
+    /** Maps a comparator to an equivalent transparent comparator, which is
+      * used by the storage containers to look up keys without building a
+      * std::string. */
+    template<typename Comparator>
+    struct TransparentComparator
+    {
+        using type = Comparator;
+    };
+
+    template<>
+    struct TransparentComparator<std::less<std::string>>
+    {
+        using type = StringLess;
+    };
+
+    /************************************************
+     * Storage Containers
+     ************************************************/
+
+    /** Determines if the given functor has the is_transparent member type. */
+    template<typename Functor, typename = void>
+    struct IsTransparent : std::false_type
+    {};
+
+    template<typename Functor>
+    struct IsTransparent<Functor, typename VoidType<typename Functor::is_transparent>::type> : std::true_type
+    {};
+
+    /** Enables heterogeneous lookups of keys of type K for a container whose
+      * functors are transparent. */
+    template<bool Transparent, typename Key, typename K>
+    using EnableIfHeterogeneous =
+        typename std::enable_if<Transparent && !std::is_same<typename std::decay<K>::type, Key>::value>::type;
+
+    /** Builds a key from a heterogeneous lookup key, if it has to be inserted.
+      * The memory of the key is obtained from the given allocator. */
+    template<typename Key, typename Allocator>
+    inline Key makeKey(const StringView key, const Allocator &alloc)
+    {
+        return Key(key.data(), key.size(), typename Key::allocator_type(alloc));
+    }
+
+    template<typename Allocator, typename T>
+    using RebindAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    /** Associative container which keeps its elements in a std::map.
+      * If the comparator is transparent, elements can be looked up and
+      * accessed by string literals and string views without building a
+      * std::string. std::map only supports heterogeneous lookups since
+      * C++14, on C++11 a temporary key is built for names which do not fit
+      * into the small string buffer. */
+    template<typename Key, typename T, typename Compare, typename Allocator = std::allocator<char>>
+    class TreeMap : public std::map<Key, T, Compare, RebindAlloc<Allocator, std::pair<const Key, T>>>
+    {
+    private:
+        using Base = std::map<Key, T, Compare, RebindAlloc<Allocator, std::pair<const Key, T>>>;
+
+        template<typename K>
+        using EnableIfHeterogeneous = ini::EnableIfHeterogeneous<IsTransparent<Compare>::value, Key, K>;
+
+#ifndef __cpp_lib_generic_associative_lookup
+        /** Finds the element with the given key in the given map. Keys
+          * which fit into the small string buffer are built without
+          * allocating, longer keys are built on the heap. */
+        template<typename Map, typename K>
+        static auto findIn(Map &map, const K &key) -> decltype(map.begin())
+        {
+            const StringView name(key);
+            Key buffer{typename Key::allocator_type(map.get_allocator())};
+            if(name.size() > buffer.capacity())
+                return map.Base::find(makeKey<Key>(name, map.get_allocator()));
+            buffer.assign(name.data(), name.size());
+            return map.Base::find(buffer);
+        }
+#endif
+
+        template<typename K>
+        typename Base::iterator findHeterogeneous(const K &key)
+        {
+#ifdef __cpp_lib_generic_associative_lookup
+            return Base::find(key);
+#else
+            return findIn(*this, key);
+#endif
+        }
+
+        template<typename K>
+        typename Base::const_iterator findHeterogeneous(const K &key) const
+        {
+#ifdef __cpp_lib_generic_associative_lookup
+            return Base::find(key);
+#else
+            return findIn(*this, key);
+#endif
+        }
+
+        template<typename K, typename... Args>
+        std::pair<typename Base::iterator, bool> tryEmplace(K &&key, Args &&...args)
+        {
+            typename Base::iterator it = Base::lower_bound(key);
+            if(it != this->end() && !this->key_comp()(key, it->first))
+                return std::make_pair(it, false);
+            it = this->emplace_hint(it,
+                std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            return std::make_pair(it, true);
+        }
+
+    public:
+        using typename Base::allocator_type;
+        using typename Base::const_iterator;
+        using typename Base::iterator;
+        using typename Base::size_type;
+
+        using Base::Base;
+
+        TreeMap() = default;
+
+        iterator find(const Key &key)
+        {
+            return Base::find(key);
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            return Base::find(key);
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        iterator find(const K &key)
+        {
+            return findHeterogeneous(key);
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        const_iterator find(const K &key) const
+        {
+            return findHeterogeneous(key);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return Base::count(key);
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        size_type count(const K &key) const
+        {
+            return findHeterogeneous(key) != this->end() ? 1 : 0;
+        }
+
+        bool contains(const Key &key) const
+        {
+            return Base::find(key) != this->end();
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        bool contains(const K &key) const
+        {
+            return findHeterogeneous(key) != this->end();
+        }
+
+        T &at(const Key &key)
+        {
+            return Base::at(key);
+        }
+
+        const T &at(const Key &key) const
+        {
+            return Base::at(key);
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        T &at(const K &key)
+        {
+            iterator it = findHeterogeneous(key);
+            if(it == this->end())
+                throw std::out_of_range("key not found");
+            return it->second;
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        const T &at(const K &key) const
+        {
+            const_iterator it = findHeterogeneous(key);
+            if(it == this->end())
+                throw std::out_of_range("key not found");
+            return it->second;
+        }
+
+        T &operator[](const Key &key)
+        {
+            return Base::operator[](key);
+        }
+
+        T &operator[](Key &&key)
+        {
+            return Base::operator[](std::move(key));
+        }
+
+        /** Inserts an element with the given key and the value constructed
+          * from args if the key does not exist yet. Neither the key nor args
+          * are moved from if the key exists. */
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args)
+        {
+            return tryEmplace(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args)
+        {
+            return tryEmplace(std::move(key), std::forward<Args>(args)...);
+        }
+
+        /** Accesses the element with the given key. The key is only copied
+          * into a std::string if the element has to be inserted. */
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        T &operator[](const K &key)
+        {
+            iterator it = findHeterogeneous(key);
+            if(it == this->end())
+                it = this->emplace_hint(it,
+                    std::piecewise_construct,
+                    std::forward_as_tuple(makeKey<Key>(key, this->get_allocator())),
+                    std::forward_as_tuple());
+            return it->second;
+        }
+    };
+
+    /** Associative container which keeps its elements sorted in a std::vector.
+      * Lookups are binary searches over contiguous memory, which is much more
+      * cache friendly than walking the nodes of a std::map. Inserting and
+      * erasing elements is linear in the size of the container and invalidates
+      * all references to its elements. */
+    template<typename Key, typename T, typename Compare, typename Allocator = std::allocator<char>>
+    class FlatMap
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using key_compare = Compare;
+        using allocator_type = RebindAlloc<Allocator, value_type>;
+        using size_type = std::size_t;
+        using iterator = typename std::vector<value_type, allocator_type>::iterator;
+        using const_iterator = typename std::vector<value_type, allocator_type>::const_iterator;
+
+    private:
+        template<typename K>
+        using EnableIfHeterogeneous = ini::EnableIfHeterogeneous<IsTransparent<Compare>::value, Key, K>;
+
+        std::vector<value_type, allocator_type> values_;
+        Compare comp_;
+
+        template<typename K>
+        const_iterator lowerBound(const K &key) const
+        {
+            const Compare &comp = comp_;
+            return std::lower_bound(values_.begin(), values_.end(), key, [&comp](const value_type &lhs, const K &rhs) {
+                return comp(lhs.first, rhs);
+            });
+        }
+
+        template<typename K>
+        const_iterator findKey(const K &key) const
+        {
+            const_iterator it = lowerBound(key);
+            return it != values_.end() && !comp_(key, it->first) ? it : values_.end();
+        }
+
+        iterator toIterator(const const_iterator it)
+        {
+            return values_.begin() + (it - values_.cbegin());
+        }
+
+        /** Inserts an element with the given key and the value constructed
+          * from args, if the key does not exist yet. */
+        template<typename K, typename... Args>
+        std::pair<iterator, bool> insertUnique(K &&key, Args &&...args)
+        {
+            iterator it = toIterator(lowerBound(key));
+            if(it != values_.end() && !comp_(key, it->first))
+                return std::make_pair(it, false);
+            it = values_.emplace(it,
+                std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            return std::make_pair(it, true);
+        }
+
+        template<typename K>
+        T &access(const K &key)
+        {
+            iterator it = toIterator(lowerBound(key));
+            if(it == values_.end() || comp_(key, it->first))
+                it = values_.emplace(it,
+                    std::piecewise_construct,
+                    std::forward_as_tuple(makeKey<Key>(key, values_.get_allocator())),
+                    std::forward_as_tuple());
+            return it->second;
+        }
+
+    public:
+        FlatMap() = default;
+
+        explicit FlatMap(const allocator_type &alloc) : values_(alloc)
+        {}
+
+        FlatMap(const FlatMap &other, const allocator_type &alloc) : values_(other.values_, alloc), comp_(other.comp_)
+        {}
+
+        FlatMap(FlatMap &&other, const allocator_type &alloc)
+            : values_(std::move(other.values_), alloc), comp_(other.comp_)
+        {}
+
+        allocator_type get_allocator() const
+        {
+            return values_.get_allocator();
+        }
+
+        iterator begin()
+        {
+            return values_.begin();
+        }
+
+        const_iterator begin() const
+        {
+            return values_.begin();
+        }
+
+        const_iterator cbegin() const
+        {
+            return values_.cbegin();
+        }
+
+        iterator end()
+        {
+            return values_.end();
+        }
+
+        const_iterator end() const
+        {
+            return values_.end();
+        }
+
+        const_iterator cend() const
+        {
+            return values_.cend();
+        }
+
+        bool empty() const
+        {
+            return values_.empty();
+        }
+
+        size_type size() const
+        {
+            return values_.size();
+        }
+
+        void clear()
+        {
+            values_.clear();
+        }
+
+        void reserve(const size_type size)
+        {
+            values_.reserve(size);
+        }
+
+        key_compare key_comp() const
+        {
+            return comp_;
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return toIterator(lowerBound(key));
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return lowerBound(key);
+        }
+
+        iterator find(const Key &key)
+        {
+            return toIterator(findKey(key));
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            return findKey(key);
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        iterator find(const K &key)
+        {
+            return toIterator(findKey(key));
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        const_iterator find(const K &key) const
+        {
+            return findKey(key);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return findKey(key) != values_.end() ? 1 : 0;
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        size_type count(const K &key) const
+        {
+            return findKey(key) != values_.end() ? 1 : 0;
+        }
+
+        bool contains(const Key &key) const
+        {
+            return findKey(key) != values_.end();
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        bool contains(const K &key) const
+        {
+            return findKey(key) != values_.end();
+        }
+
+        T &at(const Key &key)
+        {
+            return const_cast<T &>(static_cast<const FlatMap &>(*this).at(key));
+        }
+
+        const T &at(const Key &key) const
+        {
+            const_iterator it = findKey(key);
+            if(it == values_.end())
+                throw std::out_of_range("key not found");
+            return it->second;
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        T &at(const K &key)
+        {
+            return const_cast<T &>(static_cast<const FlatMap &>(*this).at(key));
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        const T &at(const K &key) const
+        {
+            const_iterator it = findKey(key);
+            if(it == values_.end())
+                throw std::out_of_range("key not found");
+            return it->second;
+        }
+
+        T &operator[](const Key &key)
+        {
+            return insertUnique(key).first->second;
+        }
+
+        T &operator[](Key &&key)
+        {
+            return insertUnique(std::move(key)).first->second;
+        }
+
+        /** Accesses the element with the given key. The key is only copied
+          * into a std::string if the element has to be inserted. */
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        T &operator[](const K &key)
+        {
+            return access(key);
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return insertUnique(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return insertUnique(std::move(value.first), std::move(value.second));
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        /** Inserts an element with the given key and the value constructed
+          * from args if the key does not exist yet. Neither the key nor args
+          * are moved from if the key exists. */
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args)
+        {
+            return insertUnique(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args)
+        {
+            return insertUnique(std::move(key), std::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return values_.erase(pos);
+        }
+
+        size_type erase(const Key &key)
+        {
+            const_iterator it = findKey(key);
+            if(it == values_.end())
+                return 0;
+            values_.erase(it);
+            return 1;
+        }
+    };
+
+    /** Associative container which uses an open addressing hash table with
+      * linear probing as index over a dense std::vector of its elements.
+      * Elements are iterated in insertion order. Inserting elements invalidates
+      * all references to them, erasing an element moves the last element into
+      * its place. */
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator = std::allocator<char>>
+    class HashMap
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = RebindAlloc<Allocator, value_type>;
+        using size_type = std::size_t;
+        using iterator = typename std::vector<value_type, allocator_type>::iterator;
+        using const_iterator = typename std::vector<value_type, allocator_type>::const_iterator;
+
+    private:
+        template<typename K>
+        using EnableIfHeterogeneous =
+            ini::EnableIfHeterogeneous<IsTransparent<Hash>::value && IsTransparent<KeyEqual>::value, Key, K>;
+
+        // dense storage of all elements
+        std::vector<value_type, allocator_type> values_;
+        // hash of each element, kept to speed up rehashing and probing
+        std::vector<std::size_t, RebindAlloc<Allocator, std::size_t>> hashes_;
+        // index of the element in values_ plus one, zero marks an empty slot
+        std::vector<std::size_t, RebindAlloc<Allocator, std::size_t>> slots_;
+        Hash hash_;
+        KeyEqual equal_;
+
+        std::size_t mask() const
+        {
+            return slots_.size() - 1;
+        }
+
+        /** Returns the slot which contains the given key or the empty slot
+          * where it would have to be inserted. */
+        template<typename K>
+        std::size_t findSlot(const K &key, const std::size_t hash) const
+        {
+            std::size_t slot = hash & mask();
+            while(slots_[slot] != 0)
+            {
+                const std::size_t idx = slots_[slot] - 1;
+                if(hashes_[idx] == hash && equal_(values_[idx].first, key))
+                    return slot;
+                slot = (slot + 1) & mask();
+            }
+            return slot;
+        }
+
+        template<typename K>
+        const_iterator findKey(const K &key) const
+        {
+            if(values_.empty())
+                return values_.end();
+            const std::size_t slot = findSlot(key, hash_(key));
+            return slots_[slot] == 0 ? values_.end() : values_.begin() + (slots_[slot] - 1);
+        }
+
+        iterator toIterator(const const_iterator it)
+        {
+            return values_.begin() + (it - values_.cbegin());
+        }
+
+        /** Returns the slot which refers to the element at the given index. */
+        std::size_t slotOf(const std::size_t idx) const
+        {
+            std::size_t slot = hashes_[idx] & mask();
+            while(slots_[slot] != idx + 1)
+                slot = (slot + 1) & mask();
+            return slot;
+        }
+
+        void rehash(const std::size_t capacity)
+        {
+            slots_.assign(capacity, 0);
+            for(std::size_t i = 0; i < values_.size(); ++i)
+            {
+                std::size_t slot = hashes_[i] & mask();
+                while(slots_[slot] != 0)
+                    slot = (slot + 1) & mask();
+                slots_[slot] = i + 1;
+            }
+        }
+
+        /** Grows the table if inserting one more element would exceed the
+          * maximum load factor of 7/8. */
+        void grow()
+        {
+            if(slots_.empty())
+                rehash(8);
+            else if((values_.size() + 1) * 8 > slots_.size() * 7)
+                rehash(slots_.size() * 2);
+        }
+
+        /** Inserts an element with the given key and the value constructed
+          * from args, if the key does not exist yet. */
+        template<typename K, typename... Args>
+        std::pair<iterator, bool> insertUnique(K &&key, Args &&...args)
+        {
+            grow();
+            const std::size_t hash = hash_(key);
+            const std::size_t slot = findSlot(key, hash);
+            if(slots_[slot] != 0)
+                return std::make_pair(values_.begin() + (slots_[slot] - 1), false);
+
+            values_.emplace_back(std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            hashes_.push_back(hash);
+            slots_[slot] = values_.size();
+            return std::make_pair(values_.end() - 1, true);
+        }
+
+        template<typename K>
+        T &access(const K &key)
+        {
+            grow();
+            const std::size_t hash = hash_(key);
+            const std::size_t slot = findSlot(key, hash);
+            if(slots_[slot] != 0)
+                return values_[slots_[slot] - 1].second;
+
+            values_.emplace_back(std::piecewise_construct,
+                std::forward_as_tuple(makeKey<Key>(key, values_.get_allocator())),
+                std::forward_as_tuple());
+            hashes_.push_back(hash);
+            slots_[slot] = values_.size();
+            return values_.back().second;
+        }
+
+        void eraseSlot(std::size_t slot)
+        {
+            const std::size_t idx = slots_[slot] - 1;
+
+            // backward shift deletion keeps all probe sequences intact
+            std::size_t next = slot;
+            while(true)
+            {
+                next = (next + 1) & mask();
+                if(slots_[next] == 0)
+                    break;
+                const std::size_t home = hashes_[slots_[next] - 1] & mask();
+                // move the element back if its home slot does not lie
+                // cyclically within (slot, next]
+                const bool between = slot <= next ? (slot < home && home <= next) : (slot < home || home <= next);
+                if(!between)
+                {
+                    slots_[slot] = slots_[next];
+                    slot = next;
+                }
+            }
+            slots_[slot] = 0;
+
+            // keep the element storage dense by moving the last element into
+            // the gap
+            const std::size_t last = values_.size() - 1;
+            if(idx != last)
+            {
+                slots_[slotOf(last)] = idx + 1;
+                values_[idx] = std::move(values_[last]);
+                hashes_[idx] = hashes_[last];
+            }
+            values_.pop_back();
+            hashes_.pop_back();
+        }
+
+    public:
+        HashMap() = default;
+
+        explicit HashMap(const allocator_type &alloc) : values_(alloc), hashes_(alloc), slots_(alloc)
+        {}
+
+        HashMap(const HashMap &other, const allocator_type &alloc)
+            : values_(other.values_, alloc),
+              hashes_(other.hashes_, alloc),
+              slots_(other.slots_, alloc),
+              hash_(other.hash_),
+              equal_(other.equal_)
+        {}
+
+        HashMap(HashMap &&other, const allocator_type &alloc)
+            : values_(std::move(other.values_), alloc),
+              hashes_(std::move(other.hashes_), alloc),
+              slots_(std::move(other.slots_), alloc),
+              hash_(other.hash_),
+              equal_(other.equal_)
+        {
+            other.clear();
+        }
+
+        allocator_type get_allocator() const
+        {
+            return values_.get_allocator();
+        }
+
+        iterator begin()
+        {
+            return values_.begin();
+        }
+
+        const_iterator begin() const
+        {
+            return values_.begin();
+        }
+
+        const_iterator cbegin() const
+        {
+            return values_.cbegin();
+        }
+
+        iterator end()
+        {
+            return values_.end();
+        }
+
+        const_iterator end() const
+        {
+            return values_.end();
+        }
+
+        const_iterator cend() const
+        {
+            return values_.cend();
+        }
+
+        bool empty() const
+        {
+            return values_.empty();
+        }
+
+        size_type size() const
+        {
+            return values_.size();
+        }
+
+        void clear()
+        {
+            values_.clear();
+            hashes_.clear();
+            slots_.clear();
+        }
+
+        void reserve(const size_type size)
+        {
+            values_.reserve(size);
+            hashes_.reserve(size);
+            std::size_t capacity = 8;
+            while(size * 8 > capacity * 7)
+                capacity *= 2;
+            if(capacity > slots_.size())
+                rehash(capacity);
+        }
+
+        hasher hash_function() const
+        {
+            return hash_;
+        }
+
+        key_equal key_eq() const
+        {
+            return equal_;
+        }
+
+        iterator find(const Key &key)
+        {
+            return toIterator(findKey(key));
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            return findKey(key);
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        iterator find(const K &key)
+        {
+            return toIterator(findKey(key));
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        const_iterator find(const K &key) const
+        {
+            return findKey(key);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return findKey(key) != values_.end() ? 1 : 0;
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        size_type count(const K &key) const
+        {
+            return findKey(key) != values_.end() ? 1 : 0;
+        }
+
+        bool contains(const Key &key) const
+        {
+            return findKey(key) != values_.end();
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        bool contains(const K &key) const
+        {
+            return findKey(key) != values_.end();
+        }
+
+        T &at(const Key &key)
+        {
+            return const_cast<T &>(static_cast<const HashMap &>(*this).at(key));
+        }
+
+        const T &at(const Key &key) const
+        {
+            const_iterator it = findKey(key);
+            if(it == values_.end())
+                throw std::out_of_range("key not found");
+            return it->second;
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        T &at(const K &key)
+        {
+            return const_cast<T &>(static_cast<const HashMap &>(*this).at(key));
+        }
+
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        const T &at(const K &key) const
+        {
+            const_iterator it = findKey(key);
+            if(it == values_.end())
+                throw std::out_of_range("key not found");
+            return it->second;
+        }
+
+        T &operator[](const Key &key)
+        {
+            return insertUnique(key).first->second;
+        }
+
+        T &operator[](Key &&key)
+        {
+            return insertUnique(std::move(key)).first->second;
+        }
+
+        /** Accesses the element with the given key. The key is only copied
+          * into a std::string if the element has to be inserted. */
+        template<typename K, typename = EnableIfHeterogeneous<K>>
+        T &operator[](const K &key)
+        {
+            return access(key);
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return insertUnique(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return insertUnique(std::move(value.first), std::move(value.second));
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        /** Inserts an element with the given key and the value constructed
+          * from args if the key does not exist yet. Neither the key nor args
+          * are moved from if the key exists. */
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args)
+        {
+            return insertUnique(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args)
+        {
+            return insertUnique(std::move(key), std::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            const std::size_t idx = static_cast<std::size_t>(pos - values_.cbegin());
+            eraseSlot(slotOf(idx));
+            return values_.begin() + idx;
+        }
+
+        size_type erase(const Key &key)
+        {
+            if(values_.empty())
+                return 0;
+            const std::size_t slot = findSlot(key, hash_(key));
+            if(slots_[slot] == 0)
+                return 0;
+            eraseSlot(slot);
+            return 1;
+        }
+    };
+
+    /** Maps a comparator to the hash and equality functors which are used by
+      * HashStorage. Specialize this template to use HashStorage with custom
+      * comparators. */
+    template<typename Comparator>
+    struct HashTraits
+    {};
+
+    template<>
+    struct HashTraits<std::less<std::string>>
+    {
+        using hasher = StringHash;
+        using key_equal = StringEqual;
+    };
+
+    template<>
+    struct HashTraits<StringLess>
+    {
+        using hasher = StringHash;
+        using key_equal = StringEqual;
+    };
+
+    template<>
+    struct HashTraits<StringInsensitiveLess>
+    {
+        using hasher = StringInsensitiveHash;
+        using key_equal = StringInsensitiveEqual;
+    };
+
+    /** Storage policy which keeps sections and fields in a std::map.
+      * std::less<std::string> is replaced by the transparent StringLess,
+      * so the containers are no std::map with the default comparator. */
+    struct MapStorage
+    {
+        template<typename Key, typename T, typename Comparator, typename Allocator = std::allocator<char>>
+        using container = TreeMap<Key, T, typename TransparentComparator<Comparator>::type, Allocator>;
+    };
+
+    /** Storage policy which keeps sections and fields in a FlatMap. */
+    struct FlatStorage
+    {
+        template<typename Key, typename T, typename Comparator, typename Allocator = std::allocator<char>>
+        using container = FlatMap<Key, T, typename TransparentComparator<Comparator>::type, Allocator>;
+    };
+
+    /** Storage policy which keeps sections and fields in a HashMap.
+      * The hash and equality functors are taken from HashTraits<Comparator>. */
+    struct HashStorage
+    {
+        template<typename Key, typename T, typename Comparator, typename Allocator = std::allocator<char>>
+        using container = HashMap<Key,
+            T,
+            typename HashTraits<Comparator>::hasher,
+            typename HashTraits<Comparator>::key_equal,
+            Allocator>;
+    };
+
+    /************************************************
+     * Binary Format
+     ************************************************/
+
+    /** Determines if names compared by the given comparator are matched
+      * ignoring the case of ASCII characters in binary ini files. All other
+      * comparators match names exactly. */
+    template<typename Comparator>
+    struct IsCaseInsensitive
+        : std::is_same<typename TransparentComparator<Comparator>::type, StringInsensitiveLess>
+    {};
+
+    /** Header at the start of a binary ini file. The header is followed by
+      * the section records, the index of the sections, the field records,
+      * the indexes of the fields of each section and the null-terminated
+      * names and values. All offsets in the records are relative to the
+      * record which holds them. */
+    struct IniBinaryHeader
+    {
+        char magic[4];
+        std::uint32_t byteOrder;
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint32_t sectionCount;
+        std::uint32_t fieldCount;
+        std::uint64_t size;
+        // hash of all bytes after the header
+        std::uint64_t checksum;
+
+        enum : std::uint32_t
+        {
+            ByteOrderMark = 0x01020304,
+            CurrentVersion = 1,
+            // flag which is set if names are matched ignoring case
+            CaseInsensitive = 1
+        };
+    };
+
+    /** Entry of the index of a binary ini file. The entries are sorted by the
+      * hash of the name, so a name is found by a binary search followed by
+      * comparing the few names with the same hash. */
+    struct IniBinaryIndexEntry
+    {
+        std::uint32_t hash;
+        std::uint32_t index;
+    };
+
+    /** Returns the 32 bit hash stored in the index of a binary ini file. */
+    inline std::uint32_t hashBinaryName(const StringView name, const bool insensitive)
+    {
+        return static_cast<std::uint32_t>(hashBytes(name.data(), name.size(), insensitive));
+    }
+
+    /** Returns the first record in the given index whose name equals the
+      * given name or nullptr if none does. */
+    template<typename Record>
+    const Record *findBinaryRecord(const Record *records,
+        const IniBinaryIndexEntry *index,
+        const std::size_t count,
+        const StringView name,
+        const bool insensitive)
+    {
+        const std::uint32_t hash = hashBinaryName(name, insensitive);
+        const IniBinaryIndexEntry *end = index + count;
+        const IniBinaryIndexEntry *it = std::lower_bound(index, end, hash,
+            [](const IniBinaryIndexEntry &entry, const std::uint32_t value) { return entry.hash < value; });
+        for(; it != end && it->hash == hash; ++it)
+        {
+            const Record &record = records[it->index];
+            const StringView recordName = record.name();
+            if(insensitive ? recordName.size() == name.size() &&
+                    compareInsensitive(recordName.data(), recordName.size(), name.data(), name.size()) == 0
+                           : recordName == name)
+                return &record;
+        }
+        return nullptr;
+    }
+
+    /** Field of a binary ini file. Objects of this type only exist inside
+      * the buffer of a binary ini file, the value is converted by Convert<T>
+      * in place on every access. */
+    class IniBinaryField
+    {
+    private:
+        friend class IniBinaryWriter;
+        friend class IniBinaryView;
+
+        IniBinaryField() = default;
+
+        std::uint32_t nameOffset_;
+        std::uint32_t nameSize_;
+        std::uint32_t valueOffset_;
+        std::uint32_t valueSize_;
+
+        const char *address(const std::uint32_t offset) const
+        {
+            return reinterpret_cast<const char *>(this) + offset;
+        }
+
+    public:
+        IniBinaryField(const IniBinaryField &) = delete;
+        IniBinaryField &operator=(const IniBinaryField &) = delete;
+
+        /** Returns the name of this field. */
+        StringView name() const
+        {
+            return StringView(address(nameOffset_), nameSize_);
+        }
+
+        /** Returns the raw value of this field. The value is followed by a
+          * null character. */
+        StringView str() const
+        {
+            return StringView(address(valueOffset_), valueSize_);
+        }
+
+        /** Converts the value of this field to T. */
+        template<typename T>
+        T as() const
+        {
+            return convertRange<T>(address(valueOffset_), valueSize_);
+        }
+    };
+
+    /** Section of a binary ini file. Objects of this type only exist inside
+      * the buffer of a binary ini file. Iterating a section yields its fields
+      * in the order of the ini file it was written from. */
+    class IniBinarySection
+    {
+    private:
+        friend class IniBinaryWriter;
+        friend class IniBinaryView;
+
+        IniBinarySection() = default;
+
+        std::uint32_t nameOffset_;
+        std::uint32_t nameSize_;
+        std::uint32_t fieldsOffset_;
+        std::uint32_t fieldCount_;
+        std::uint32_t indexOffset_;
+        std::uint32_t flags_;
+
+        const char *address(const std::uint32_t offset) const
+        {
+            return reinterpret_cast<const char *>(this) + offset;
+        }
+
+    public:
+        using const_iterator = const IniBinaryField *;
+
+        IniBinarySection(const IniBinarySection &) = delete;
+        IniBinarySection &operator=(const IniBinarySection &) = delete;
+
+        /** Returns the name of this section. */
+        StringView name() const
+        {
+            return StringView(address(nameOffset_), nameSize_);
+        }
+
+        std::size_t size() const
+        {
+            return fieldCount_;
+        }
+
+        bool empty() const
+        {
+            return fieldCount_ == 0;
+        }
+
+        const_iterator begin() const
+        {
+            return reinterpret_cast<const IniBinaryField *>(address(fieldsOffset_));
+        }
+
+        const_iterator end() const
+        {
+            return begin() + fieldCount_;
+        }
+
+        /** Returns the field with the given name or nullptr if it does not
+          * exist. */
+        const IniBinaryField *get(const StringView name) const
+        {
+            return findBinaryRecord(begin(),
+                reinterpret_cast<const IniBinaryIndexEntry *>(address(indexOffset_)),
+                fieldCount_,
+                name,
+                (flags_ & IniBinaryHeader::CaseInsensitive) != 0);
+        }
+
+        /** Returns the field with the given name or end() if it does not
+          * exist. */
+        const_iterator find(const StringView name) const
+        {
+            const IniBinaryField *field = get(name);
+            return field != nullptr ? field : end();
+        }
+
+        bool contains(const StringView name) const
+        {
+            return get(name) != nullptr;
+        }
+
+        std::size_t count(const StringView name) const
+        {
+            return get(name) != nullptr ? 1 : 0;
+        }
+
+        const IniBinaryField &at(const StringView name) const
+        {
+            const IniBinaryField *field = get(name);
+            if(field == nullptr)
+                throw std::out_of_range("key not found");
+            return *field;
+        }
+
+        /** Returns the value of the field with the given name converted to T
+          * or the default value if the field does not exist. */
+        template<typename T>
+        T getOr(const StringView name, const T &defaultValue) const
+        {
+            const IniBinaryField *field = get(name);
+            return field != nullptr ? field->as<T>() : defaultValue;
+        }
+
+        std::string getOr(const StringView name, const char *defaultValue) const
+        {
+            return getOr<std::string>(name, std::string(defaultValue));
+        }
+    };
+
+    /** Writes binary ini files. Sections and fields are added in the order in
+      * which they should be iterated, the names and values are not copied
+      * until write() is called. */
+    class IniBinaryWriter
+    {
+    private:
+        struct SectionEntry
+        {
+            StringView name;
+            std::size_t firstField;
+        };
+
+        struct FieldEntry
+        {
+            StringView name;
+            StringView value;
+        };
+
+        std::vector<SectionEntry> sections_;
+        std::vector<FieldEntry> fields_;
+
+        static std::uint32_t offset(const std::size_t from, const std::size_t to)
+        {
+            return static_cast<std::uint32_t>(to - from);
+        }
+
+        static std::size_t writeString(std::string &out, std::size_t pos, const StringView str)
+        {
+            if(!str.empty())
+                std::memcpy(&out[pos], str.data(), str.size());
+            return pos + str.size() + 1;
+        }
+
+        static void writeIndex(std::string &out,
+            const std::size_t pos,
+            std::vector<IniBinaryIndexEntry> &index)
+        {
+            std::sort(index.begin(), index.end(), [](const IniBinaryIndexEntry &lhs, const IniBinaryIndexEntry &rhs) {
+                return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.index < rhs.index;
+            });
+            if(!index.empty())
+                std::memcpy(&out[pos], index.data(), index.size() * sizeof(IniBinaryIndexEntry));
+        }
+
+    public:
+        /** Starts a new section. All fields added afterwards belong to it. */
+        void addSection(const StringView name)
+        {
+            sections_.push_back(SectionEntry{name, fields_.size()});
+        }
+
+        /** Adds a field to the last section.
+          * @throws std::logic_error if no section was added before. */
+        void addField(const StringView name, const StringView value)
+        {
+            if(sections_.empty())
+                throw std::logic_error("binary ini field added without section");
+            fields_.push_back(FieldEntry{name, value});
+        }
+
+        void clear()
+        {
+            sections_.clear();
+            fields_.clear();
+        }
+
+        /** Writes the binary ini file to the given string.
+          * @param out string which receives the binary ini file.
+          * @param insensitive true if names should be matched ignoring the
+          *        case of ASCII characters.
+          * @throws std::length_error if the file would exceed 4GB. */
+        void write(std::string &out, const bool insensitive) const
+        {
+            const std::size_t sectionsPos = sizeof(IniBinaryHeader);
+            const std::size_t sectionIndexPos = sectionsPos + sections_.size() * sizeof(IniBinarySection);
+            const std::size_t fieldsPos = sectionIndexPos + sections_.size() * sizeof(IniBinaryIndexEntry);
+            const std::size_t fieldIndexPos = fieldsPos + fields_.size() * sizeof(IniBinaryField);
+            const std::size_t stringsPos = fieldIndexPos + fields_.size() * sizeof(IniBinaryIndexEntry);
+            const std::uint32_t flags = insensitive ? std::uint32_t(IniBinaryHeader::CaseInsensitive) : 0;
+
+            std::size_t size = stringsPos;
+            for(const SectionEntry &section : sections_)
+                size += section.name.size() + 1;
+            for(const FieldEntry &field : fields_)
+                size += field.name.size() + field.value.size() + 2;
+            if(size > std::numeric_limits<std::uint32_t>::max())
+                throw std::length_error("binary ini file exceeds 4GB");
+
+            out.assign(size, '\0');
+            std::size_t stringPos = stringsPos;
+            std::vector<IniBinaryIndexEntry> index;
+            index.reserve(sections_.size());
+            for(std::size_t i = 0; i < sections_.size(); ++i)
+            {
+                const std::size_t firstField = sections_[i].firstField;
+                const std::size_t endField = i + 1 < sections_.size() ? sections_[i + 1].firstField : fields_.size();
+                const std::size_t pos = sectionsPos + i * sizeof(IniBinarySection);
+                IniBinarySection section;
+                section.nameOffset_ = offset(pos, stringPos);
+                section.nameSize_ = static_cast<std::uint32_t>(sections_[i].name.size());
+                section.fieldsOffset_ = offset(pos, fieldsPos + firstField * sizeof(IniBinaryField));
+                section.fieldCount_ = static_cast<std::uint32_t>(endField - firstField);
+                section.indexOffset_ = offset(pos, fieldIndexPos + firstField * sizeof(IniBinaryIndexEntry));
+                section.flags_ = flags;
+                std::memcpy(&out[pos], &section, sizeof(section));
+                stringPos = writeString(out, stringPos, sections_[i].name);
+                index.push_back(IniBinaryIndexEntry{
+                    hashBinaryName(sections_[i].name, insensitive), static_cast<std::uint32_t>(i)});
+            }
+            writeIndex(out, sectionIndexPos, index);
+
+            for(std::size_t i = 0; i < sections_.size(); ++i)
+            {
+                const std::size_t firstField = sections_[i].firstField;
+                const std::size_t endField = i + 1 < sections_.size() ? sections_[i + 1].firstField : fields_.size();
+                index.clear();
+                for(std::size_t j = firstField; j < endField; ++j)
+                {
+                    const std::size_t pos = fieldsPos + j * sizeof(IniBinaryField);
+                    IniBinaryField field;
+                    field.nameOffset_ = offset(pos, stringPos);
+                    field.nameSize_ = static_cast<std::uint32_t>(fields_[j].name.size());
+                    stringPos = writeString(out, stringPos, fields_[j].name);
+                    field.valueOffset_ = offset(pos, stringPos);
+                    field.valueSize_ = static_cast<std::uint32_t>(fields_[j].value.size());
+                    stringPos = writeString(out, stringPos, fields_[j].value);
+                    std::memcpy(&out[pos], &field, sizeof(field));
+                    index.push_back(IniBinaryIndexEntry{
+                        hashBinaryName(fields_[j].name, insensitive), static_cast<std::uint32_t>(j - firstField)});
+                }
+                writeIndex(out, fieldIndexPos + firstField * sizeof(IniBinaryIndexEntry), index);
+            }
+
+            IniBinaryHeader header;
+            std::memcpy(header.magic, "INIB", 4);
+            header.byteOrder = IniBinaryHeader::ByteOrderMark;
+            header.version = IniBinaryHeader::CurrentVersion;
+            header.flags = flags;
+            header.sectionCount = static_cast<std::uint32_t>(sections_.size());
+            header.fieldCount = static_cast<std::uint32_t>(fields_.size());
+            header.size = size;
+            header.checksum = hashBytes(out.data() + sizeof(header), size - sizeof(header), false);
+            std::memcpy(&out[0], &header, sizeof(header));
+        }
+    };
+
+    /** Read-only view of a binary ini file in memory. Opening a view only
+      * validates the header and the bounds of all records, sections and
+      * fields are looked up in place
+      * through the hash indexes of the file without parsing or allocating.
+      * The accessors match the ones of IniFile, iterating a view yields its
+      * sections in the order of the ini file it was written from. */
+    class IniBinaryView
+    {
+    private:
+        const char *data_ = nullptr;
+        IniBinaryHeader header_ = IniBinaryHeader();
+
+        const IniBinaryIndexEntry *index() const
+        {
+            return reinterpret_cast<const IniBinaryIndexEntry *>(end());
+        }
+
+        void validate(const std::size_t size, const bool verify) const
+        {
+            if(reinterpret_cast<std::uintptr_t>(data_) % alignof(IniBinaryHeader) != 0)
+                throw std::invalid_argument("binary ini buffer is not aligned");
+            if(std::memcmp(header_.magic, "INIB", 4) != 0)
+                throw std::invalid_argument("buffer is not a binary ini file");
+            if(header_.byteOrder != IniBinaryHeader::ByteOrderMark)
+                throw std::invalid_argument("binary ini file has a different byte order");
+            if(header_.version != IniBinaryHeader::CurrentVersion)
+                throw std::invalid_argument("binary ini file has an unsupported version");
+
+            const std::uint64_t tables = sizeof(IniBinaryHeader) +
+                std::uint64_t(header_.sectionCount) * (sizeof(IniBinarySection) + sizeof(IniBinaryIndexEntry)) +
+                std::uint64_t(header_.fieldCount) * (sizeof(IniBinaryField) + sizeof(IniBinaryIndexEntry));
+            if(header_.size > size || tables > header_.size)
+                throw std::invalid_argument("binary ini file is truncated");
+            if(verify &&
+                hashBytes(data_ + sizeof(IniBinaryHeader), header_.size - sizeof(IniBinaryHeader), false) !=
+                    header_.checksum)
+                throw std::invalid_argument("binary ini file is corrupt");
+            validateRecords();
+        }
+
+        /** Returns true if the string at the given offset from the record at
+          * pos lies in the string area and is null-terminated. */
+        bool validString(const std::uint64_t pos,
+            const std::uint32_t offset,
+            const std::uint32_t size,
+            const std::uint64_t stringsPos) const
+        {
+            const std::uint64_t begin = pos + offset;
+            return begin >= stringsPos && begin + size < header_.size && data_[begin + size] == '\0';
+        }
+
+        /** Checks that all offsets and indexes of the records point into the
+          * file, so neither a corrupt nor a crafted file is read out of
+          * bounds. The fields of the sections have to be stored in the order
+          * of the sections, like IniBinaryWriter does. Each record is visited
+          * once, no string is parsed. */
+        void validateRecords() const
+        {
+            const std::uint64_t sectionIndexPos =
+                sizeof(IniBinaryHeader) + std::uint64_t(header_.sectionCount) * sizeof(IniBinarySection);
+            const std::uint64_t fieldsPos =
+                sectionIndexPos + std::uint64_t(header_.sectionCount) * sizeof(IniBinaryIndexEntry);
+            const std::uint64_t fieldIndexPos = fieldsPos + std::uint64_t(header_.fieldCount) * sizeof(IniBinaryField);
+            const std::uint64_t stringsPos =
+                fieldIndexPos + std::uint64_t(header_.fieldCount) * sizeof(IniBinaryIndexEntry);
+
+            const IniBinaryIndexEntry *sectionIndex = index();
+            for(std::uint32_t i = 0; i < header_.sectionCount; ++i)
+            {
+                if(sectionIndex[i].index >= header_.sectionCount)
+                    throw std::invalid_argument("binary ini file is corrupt");
+            }
+
+            std::uint64_t firstField = 0;
+            for(std::uint32_t i = 0; i < header_.sectionCount; ++i)
+            {
+                const IniBinarySection &section = begin()[i];
+                const std::uint64_t pos = sizeof(IniBinaryHeader) + std::uint64_t(i) * sizeof(IniBinarySection);
+                if(!validString(pos, section.nameOffset_, section.nameSize_, stringsPos) ||
+                    section.fieldCount_ > header_.fieldCount - firstField ||
+                    pos + section.fieldsOffset_ != fieldsPos + firstField * sizeof(IniBinaryField) ||
+                    pos + section.indexOffset_ != fieldIndexPos + firstField * sizeof(IniBinaryIndexEntry))
+                    throw std::invalid_argument("binary ini file is corrupt");
+
+                const IniBinaryIndexEntry *fieldIndex =
+                    reinterpret_cast<const IniBinaryIndexEntry *>(section.address(section.indexOffset_));
+                for(std::uint32_t j = 0; j < section.fieldCount_; ++j)
+                {
+                    const IniBinaryField &field = section.begin()[j];
+                    const std::uint64_t fieldPos = fieldsPos + (firstField + j) * sizeof(IniBinaryField);
+                    if(fieldIndex[j].index >= section.fieldCount_ ||
+                        !validString(fieldPos, field.nameOffset_, field.nameSize_, stringsPos) ||
+                        !validString(fieldPos, field.valueOffset_, field.valueSize_, stringsPos))
+                        throw std::invalid_argument("binary ini file is corrupt");
+                }
+                firstField += section.fieldCount_;
+            }
+            if(firstField != header_.fieldCount)
+                throw std::invalid_argument("binary ini file is corrupt");
+        }
+
+    protected:
+        void reset(const char *data, const std::size_t size, const bool verify)
+        {
+            if(size < sizeof(IniBinaryHeader))
+                throw std::invalid_argument("binary ini file is truncated");
+            IniBinaryHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            IniBinaryView view;
+            view.data_ = data;
+            view.header_ = header;
+            view.validate(size, verify);
+            *this = view;
+        }
+
+    public:
+        using const_iterator = const IniBinarySection *;
+
+        IniBinaryView() = default;
+
+        /** Creates a view of the binary ini file in the given buffer. The
+          * buffer has to be aligned to 8 bytes and has to outlive the view.
+          * @param data pointer to the binary ini file.
+          * @param size number of bytes in the buffer.
+          * @param verify true if the checksum of the file should be
+          *        verified, which reads the whole buffer once.
+          * @throws std::invalid_argument if the buffer does not hold a valid
+          *         binary ini file. */
+        IniBinaryView(const char *data, const std::size_t size, const bool verify = true)
+        {
+            reset(data, size, verify);
+        }
+
+        /** Returns true if names are matched ignoring the case of ASCII
+          * characters. */
+        bool caseInsensitive() const
+        {
+            return (header_.flags & IniBinaryHeader::CaseInsensitive) != 0;
+        }
+
+        /** Returns the number of bytes of the binary ini file. */
+        std::size_t bytes() const
+        {
+            return static_cast<std::size_t>(header_.size);
+        }
+
+        std::size_t size() const
+        {
+            return header_.sectionCount;
+        }
+
+        bool empty() const
+        {
+            return header_.sectionCount == 0;
+        }
+
+        const_iterator begin() const
+        {
+            return data_ != nullptr ? reinterpret_cast<const IniBinarySection *>(data_ + sizeof(IniBinaryHeader))
+                                    : nullptr;
+        }
+
+        const_iterator end() const
+        {
+            return begin() + header_.sectionCount;
+        }
+
+        /** Returns the section with the given name or nullptr if it does not
+          * exist. */
+        const IniBinarySection *get(const StringView name) const
+        {
+            return findBinaryRecord(begin(), index(), header_.sectionCount, name, caseInsensitive());
+        }
+
+        /** Returns the field with the given name in the given section or
+          * nullptr if it does not exist. */
+        const IniBinaryField *get(const StringView section, const StringView name) const
+        {
+            const IniBinarySection *sec = get(section);
+            return sec != nullptr ? sec->get(name) : nullptr;
+        }
+
+        /** Returns the section with the given name or end() if it does not
+          * exist. */
+        const_iterator find(const StringView name) const
+        {
+            const IniBinarySection *section = get(name);
+            return section != nullptr ? section : end();
+        }
+
+        bool contains(const StringView name) const
+        {
+            return get(name) != nullptr;
+        }
+
+        std::size_t count(const StringView name) const
+        {
+            return get(name) != nullptr ? 1 : 0;
+        }
+
+        const IniBinarySection &at(const StringView name) const
+        {
+            const IniBinarySection *section = get(name);
+            if(section == nullptr)
+                throw std::out_of_range("key not found");
+            return *section;
+        }
+
+        /** Returns the value of the given field converted to T or the default
+          * value if the section or the field does not exist. */
+        template<typename T>
+        T getOr(const StringView section, const StringView name, const T &defaultValue) const
+        {
+            const IniBinaryField *field = get(section, name);
+            return field != nullptr ? field->as<T>() : defaultValue;
+        }
+
+        std::string getOr(const StringView section, const StringView name, const char *defaultValue) const
+        {
+            return getOr<std::string>(section, name, std::string(defaultValue));
+        }
+    };
+
+    /** Binary ini file which is memory mapped if possible, so opening it
+      * costs a few page faults independent of its size. */
+    class IniBinaryFile : public IniBinaryView
+    {
+    private:
+        FileBuffer buffer_;
+
+    public:
+        IniBinaryFile() = default;
+
+        /** Opens the binary ini file at the given path, see open(). */
+        explicit IniBinaryFile(const std::string &fileName, const bool verify = true)
+        {
+            open(fileName, verify);
+        }
+
+        /** Opens the binary ini file at the given path.
+          * @param fileName path to the binary ini file.
+          * @param verify true if the checksum of the file should be verified.
+          * @throws std::invalid_argument if the file cannot be read or does
+          *         not hold a valid binary ini file. */
+        void open(const std::string &fileName, const bool verify = true)
+        {
+            close();
+            if(!buffer_.open(fileName, LoadMode::Mapped))
+                throw std::invalid_argument("unable to open binary ini file " + fileName);
+            try
+            {
+                reset(buffer_.data(), buffer_.size(), verify);
+            }
+            catch(...)
+            {
+                buffer_.close();
+                throw;
+            }
+        }
+
+        void close()
+        {
+            static_cast<IniBinaryView &>(*this) = IniBinaryView();
+            buffer_.close();
+        }
+    };
+
+#ifdef INICPP_HAS_CONSTEXPR_PARSE
+    /************************************************
+     * Compile-Time Parsing
+     ************************************************/
+
+    /** Returns the number of characters of the given ini literal without
+      * its terminating null character. */
+    template<std::size_t N>
+    constexpr std::size_t staticIniSize(const char (&text)[N])
+    {
+        return N > 0 && text[N - 1] == '\0' ? N - 1 : N;
+    }
+
+    /** Returns an upper bound for the number of sections and fields in the
+      * given ini literal, which is the number of lines that are neither
+      * empty nor comments. It can be used as capacity of a StaticIniFile. */
+    template<std::size_t N>
+    constexpr std::size_t staticIniCapacity(const char (&text)[N])
+    {
+        std::size_t result = 0;
+        bool lineStart = true;
+        const std::size_t size = staticIniSize(text);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            if(text[i] == '\n')
+                lineStart = true;
+            else if(lineStart && !IniParser::isWhitespace(text[i]))
+            {
+                lineStart = false;
+                if(text[i] != '#' && text[i] != ';')
+                    ++result;
+            }
+        }
+        return result;
+    }
+
+    /** Ini file which is parsed from a string literal at compile time, so
+      * embedded defaults cost nothing at startup. The literal is parsed with
+      * the default syntax of IniFile, duplicate fields are overwritten and
+      * parse errors are compile errors. Sections and fields are kept in a
+      * sorted table, lookups with constant names are resolved at compile
+      * time:
+      *
+      *     constexpr ini::StaticIniFile defaults("[Server]\nport=8080\n");
+      *     static_assert(defaults.at("Server", "port") == "8080");
+      *
+      * The returned values refer to the storage of the file, which has to
+      * outlive them. The capacity bounds the number of sections and fields
+      * including repeated ones, use staticIniCapacity() to size the table
+      * exactly. */
+    template<std::size_t N, std::size_t Capacity = N / 2 + 1>
+    class StaticIniFile
+    {
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /** Section header or field, the names and the value are ranges in
+          * the storage of the file. */
+        struct Entry
+        {
+            std::size_t section = 0;
+            std::size_t sectionSize = 0;
+            std::size_t name = 0;
+            std::size_t nameSize = 0;
+            std::size_t value = 0;
+            std::size_t valueSize = 0;
+            // false for the entry which marks a section header
+            bool field = false;
+        };
+
+        // unescaped names and values, which are never longer than the text
+        char storage_[N > 0 ? N : 1] = {};
+        Entry entries_[Capacity > 0 ? Capacity : 1] = {};
+        std::size_t storageSize_ = 0;
+        std::size_t count_ = 0;
+        std::size_t sectionCount_ = 0;
+
+        constexpr std::string_view view(const std::size_t pos, const std::size_t size) const
+        {
+            return std::string_view(storage_ + pos, size);
+        }
+
+        static constexpr bool isCommentPrefix(const char c)
+        {
+            return c == '#' || c == ';';
+        }
+
+        static constexpr void trimRange(const char *text, std::size_t &begin, std::size_t &end)
+        {
+            while(end != begin && IniParser::isWhitespace(text[end - 1]))
+                --end;
+            while(begin != end && IniParser::isWhitespace(text[begin]))
+                ++begin;
+        }
+
+        /** Copies the range [begin, end) of the text to the storage and drops
+          * all escape chars which precede a comment prefix. Returns the
+          * position of the copy. */
+        constexpr std::size_t store(const char *text, const std::size_t begin, const std::size_t end, std::size_t &size)
+        {
+            const std::size_t pos = storageSize_;
+            for(std::size_t i = begin; i != end; ++i)
+            {
+                if(text[i] == '\\' && i + 1 != end && isCommentPrefix(text[i + 1]))
+                    continue;
+                storage_[storageSize_++] = text[i];
+            }
+            size = storageSize_ - pos;
+            return pos;
+        }
+
+        /** Orders names by their size and then from their last char. Keys
+          * with common prefixes like numbered fields are mostly decided
+          * after a single char, which keeps the sort cheap in constant
+          * evaluation. */
+        static constexpr int compareNames(const char *lhs,
+            const std::size_t lhsSize,
+            const char *rhs,
+            const std::size_t rhsSize)
+        {
+            if(lhsSize != rhsSize)
+                return lhsSize < rhsSize ? -1 : 1;
+            for(std::size_t i = lhsSize; i != 0; --i)
+            {
+                if(lhs[i - 1] != rhs[i - 1])
+                    return static_cast<unsigned char>(lhs[i - 1]) < static_cast<unsigned char>(rhs[i - 1]) ? -1 : 1;
+            }
+            return 0;
+        }
+
+        constexpr int compare(const Entry &entry,
+            const std::string_view section,
+            const bool field,
+            const std::string_view name) const
+        {
+            const int result = compareNames(storage_ + entry.section, entry.sectionSize, section.data(), section.size());
+            if(result != 0)
+                return result;
+            if(entry.field != field)
+                return entry.field ? 1 : -1;
+            return field ? compareNames(storage_ + entry.name, entry.nameSize, name.data(), name.size()) : 0;
+        }
+
+        /** Returns the index of the first entry which is not less than the
+          * given one. */
+        constexpr std::size_t lowerBound(const std::string_view section,
+            const bool field,
+            const std::string_view name) const
+        {
+            std::size_t low = 0;
+            std::size_t high = count_;
+            while(low < high)
+            {
+                const std::size_t mid = low + (high - low) / 2;
+                if(compare(entries_[mid], section, field, name) < 0)
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            return low;
+        }
+
+        constexpr std::size_t findEntry(const std::string_view section,
+            const bool field,
+            const std::string_view name) const
+        {
+            const std::size_t pos = lowerBound(section, field, name);
+            return pos < count_ && compare(entries_[pos], section, field, name) == 0 ? pos : npos;
+        }
+
+        /** Returns the position of the entry in the text, which orders
+          * repeated sections and fields. */
+        static constexpr std::size_t order(const Entry &entry)
+        {
+            return entry.field ? entry.name : entry.section;
+        }
+
+        /** Compares the keys of two entries like compare(). Fields of the same
+          * section header share the name of the section, which is not
+          * compared again. */
+        constexpr int compareEntries(const Entry &lhs, const Entry &rhs) const
+        {
+            if(lhs.section != rhs.section)
+            {
+                const int result = compareNames(storage_ + lhs.section,
+                    lhs.sectionSize,
+                    storage_ + rhs.section,
+                    rhs.sectionSize);
+                if(result != 0)
+                    return result;
+            }
+            if(lhs.field != rhs.field)
+                return lhs.field ? 1 : -1;
+            return lhs.field ? compareNames(storage_ + lhs.name, lhs.nameSize, storage_ + rhs.name, rhs.nameSize) : 0;
+        }
+
+        /** Orders the entries by key and repeated keys by their position. */
+        constexpr bool less(const Entry &lhs, const Entry &rhs) const
+        {
+            const int result = compareEntries(lhs, rhs);
+            return result < 0 || (result == 0 && order(lhs) < order(rhs));
+        }
+
+        /** Moves the entry from the hole at the root of the heap to its
+          * position. The hole is first moved down to a leaf along the
+          * larger children and then the entry is moved up, which takes
+          * about half the comparisons of swapping it down. */
+        constexpr void siftDown(const std::size_t root, const std::size_t size, const Entry entry)
+        {
+            std::size_t hole = root;
+            std::size_t child = 2 * hole + 1;
+            while(child < size)
+            {
+                if(child + 1 < size && less(entries_[child], entries_[child + 1]))
+                    ++child;
+                entries_[hole] = entries_[child];
+                hole = child;
+                child = 2 * hole + 1;
+            }
+            while(hole > root)
+            {
+                const std::size_t parent = (hole - 1) / 2;
+                if(!less(entries_[parent], entry))
+                    break;
+                entries_[hole] = entries_[parent];
+                hole = parent;
+            }
+            entries_[hole] = entry;
+        }
+
+        /** Appends the entry, the table is sorted once the text is parsed. */
+        constexpr void append(const Entry &entry)
+        {
+            if(count_ == Capacity)
+                throw std::length_error("static ini file capacity exceeded");
+            entries_[count_++] = entry;
+        }
+
+        /** Sorts the entries with heap sort, so the number of operations in
+          * constant evaluation stays in O(n log n), and keeps only the last
+          * occurrence of repeated sections and fields. */
+        constexpr void sortEntries()
+        {
+            for(std::size_t i = count_ / 2; i != 0; --i)
+                siftDown(i - 1, count_, entries_[i - 1]);
+            // the count never exceeds the capacity, bounding the loop by it
+            // keeps GCC from warning about tables with a single entry
+            for(std::size_t end = count_ < Capacity ? count_ : Capacity; end > 1; --end)
+            {
+                // move the largest entry behind the heap
+                const Entry entry = entries_[end - 1];
+                entries_[end - 1] = entries_[0];
+                siftDown(0, end - 1, entry);
+            }
+
+            std::size_t size = 0;
+            for(std::size_t i = 0; i != count_; ++i)
+            {
+                const Entry &entry = entries_[i];
+                if(i + 1 != count_ && compareEntries(entry, entries_[i + 1]) == 0)
+                    continue;
+                if(!entry.field)
+                    ++sectionCount_;
+                entries_[size++] = entry;
+            }
+            count_ = size;
+        }
+
+        /** Parses the text line by line like IniParser. */
+        constexpr void parse(const char *text, const std::size_t size)
+        {
+            Entry section;
+            bool inSection = false;
+            std::size_t pos = 0;
+            while(pos < size)
+            {
+                std::size_t begin = pos;
+                std::size_t sep = npos;
+                std::size_t close = npos;
+                std::size_t cur = pos;
+                for(; cur < size; ++cur)
+                {
+                    const char c = text[cur];
+                    if(c == '\n')
+                        break;
+                    // comment prefixes which are escaped do not start a comment
+                    if((c == '#' || c == ';') && (cur == begin || text[cur - 1] != '\\'))
+                        break;
+                    if(c == '=' && sep == npos)
+                        sep = cur;
+                    else if(c == ']' && close == npos)
+                        close = cur;
+                }
+                std::size_t end = cur;
+                while(cur < size && text[cur] != '\n')
+                    ++cur;
+                pos = cur < size ? cur + 1 : size;
+
+                trimRange(text, begin, end);
+                if(begin == end)
+                    continue;
+
+                if(text[begin] == '[')
+                {
+                    if(close == npos)
+                        throw std::logic_error("section not closed");
+                    if(close == begin + 1)
+                        throw std::logic_error("section is empty");
+                    section.section = store(text, begin + 1, close, section.sectionSize);
+                    append(section);
+                    inSection = true;
+                    continue;
+                }
+
+                if(!inSection)
+                    throw std::logic_error("field has no section");
+                if(sep == npos)
+                    throw std::logic_error("no '=' found");
+
+                std::size_t nameBegin = begin;
+                std::size_t nameEnd = sep;
+                trimRange(text, nameBegin, nameEnd);
+                std::size_t valueBegin = sep + 1;
+                std::size_t valueEnd = end;
+                trimRange(text, valueBegin, valueEnd);
+
+                Entry field = section;
+                field.field = true;
+                field.name = store(text, nameBegin, nameEnd, field.nameSize);
+                field.value = store(text, valueBegin, valueEnd, field.valueSize);
+                append(field);
+            }
+            sortEntries();
+        }
+
+    public:
+        /** Parses the given ini literal.
+          * @throws std::logic_error if the literal is not a valid ini file,
+          *         which fails the compilation in constant expressions.
+          * @throws std::length_error if the capacity is too small. */
+        constexpr explicit StaticIniFile(const char (&text)[N])
+        {
+            parse(text, staticIniSize(text));
+        }
+
+        /** Returns the number of sections. */
+        constexpr std::size_t size() const
+        {
+            return sectionCount_;
+        }
+
+        constexpr bool empty() const
+        {
+            return sectionCount_ == 0;
+        }
+
+        /** Returns the number of fields in all sections. */
+        constexpr std::size_t fieldCount() const
+        {
+            return count_ - sectionCount_;
+        }
+
+        constexpr bool contains(const std::string_view section) const
+        {
+            return findEntry(section, false, std::string_view()) != npos;
+        }
+
+        constexpr bool contains(const std::string_view section, const std::string_view name) const
+        {
+            return findEntry(section, true, name) != npos;
+        }
+
+        /** Returns the value of the given field or std::nullopt if it does not
+          * exist. */
+        constexpr std::optional<std::string_view> get(const std::string_view section,
+            const std::string_view name) const
+        {
+            const std::size_t pos = findEntry(section, true, name);
+            if(pos == npos)
+                return std::nullopt;
+            return view(entries_[pos].value, entries_[pos].valueSize);
+        }
+
+        /** Returns the value of the given field.
+          * @throws std::out_of_range if the field does not exist, which
+          *         fails the compilation in constant expressions. */
+        constexpr std::string_view at(const std::string_view section, const std::string_view name) const
+        {
+            const std::size_t pos = findEntry(section, true, name);
+            if(pos == npos)
+                throw std::out_of_range("key not found");
+            return view(entries_[pos].value, entries_[pos].valueSize);
+        }
+
+        /** Returns the value of the given field or the default value if it
+          * does not exist. */
+        constexpr std::string_view getOr(const std::string_view section,
+            const std::string_view name,
+            const std::string_view defaultValue) const
+        {
+            const std::size_t pos = findEntry(section, true, name);
+            return pos != npos ? view(entries_[pos].value, entries_[pos].valueSize) : defaultValue;
+        }
+
+        /** Returns the value of the given field converted to T by Convert<T>
+          * or the default value if it does not exist. */
+        template<typename T,
+            typename = typename std::enable_if<!std::is_convertible<T, std::string_view>::value>::type>
+        T getOr(const std::string_view section, const std::string_view name, const T &defaultValue) const
+        {
+            const std::optional<std::string_view> value = get(section, name);
+            return value ? convertRange<T>(value->data(), value->size()) : defaultValue;
+        }
+    };
+#endif
+
+    /** Section of an ini file which maps field names to fields. The names and
+      * values of all fields are allocated with the given allocator. With
+      * std::pmr::polymorphic_allocator the memory resource of the section is
+      * passed on to all of its fields. */
+    template<typename Comparator, typename Storage = MapStorage, typename Allocator = std::allocator<char>>
+    class IniSectionBase : public Storage::template container<
+        std::basic_string<char, std::char_traits<char>, Allocator>, IniFieldBase<Allocator>, Comparator, Allocator>
+    {
+    private:
+        using Base = typename Storage::template container<
+            std::basic_string<char, std::char_traits<char>, Allocator>, IniFieldBase<Allocator>, Comparator, Allocator>;
+
+    public:
+        using allocator_type = Allocator;
+        using field_type = IniFieldBase<Allocator>;
+
+        IniSectionBase() = default;
+
+        explicit IniSectionBase(const allocator_type &alloc) : Base(typename Base::allocator_type(alloc))
+        {}
+
+        IniSectionBase(const IniSectionBase &section, const allocator_type &alloc)
+            : Base(section, typename Base::allocator_type(alloc))
+        {}
+
+        IniSectionBase(IniSectionBase &&section, const allocator_type &alloc)
+            : Base(std::move(section), typename Base::allocator_type(alloc))
+        {}
+
+        /** Returns the field with the given name or nullptr if it does not
+          * exist. The section is never changed and no key is built (except
+          * for long names in std::map on C++11), so concurrent readers need
+          * no locking. */
+        const field_type *get(const StringView name) const
+        {
+            const auto it = this->find(name);
+            return it != this->end() ? &it->second : nullptr;
+        }
+
+        /** Returns the value of the field with the given name converted to T
+          * or the default value if the field does not exist.
+          * @throws std::invalid_argument if the value cannot be converted. */
+        template<typename T>
+        T getOr(const StringView name, const T &defaultValue) const
+        {
+            const field_type *field = get(name);
+            return field != nullptr ? field->template as<T>() : defaultValue;
+        }
+
+        std::string getOr(const StringView name, const char *defaultValue) const
+        {
+            return getOr<std::string>(name, std::string(defaultValue));
+        }
+    };
+
+    using IniSection = IniSectionBase<std::less<std::string>>;
+    using IniSectionCaseInsensitive = IniSectionBase<StringInsensitiveLess>;
+
+    /** Ini file which maps section names to sections. The names and values of
+      * all sections and fields are allocated with the given allocator, so a
+      * whole document can be kept in a single arena when a
+      * std::pmr::polymorphic_allocator is used. */
+    template<typename Comparator, typename Storage = MapStorage, typename Allocator = std::allocator<char>>
+    class IniFileBase : public Storage::template container<std::basic_string<char, std::char_traits<char>, Allocator>,
+                            IniSectionBase<Comparator, Storage, Allocator>,
+                            Comparator,
+                            Allocator>
+    {
+    private:
+        using Base = typename Storage::template container<std::basic_string<char, std::char_traits<char>, Allocator>,
+            IniSectionBase<Comparator, Storage, Allocator>,
+            Comparator,
+            Allocator>;
+
+    public:
+        using allocator_type = Allocator;
+        using string_type = std::basic_string<char, std::char_traits<char>, Allocator>;
+        using field_type = IniFieldBase<Allocator>;
+        using section_type = IniSectionBase<Comparator, Storage, Allocator>;
+        using comparator_type = Comparator;
+
+    private:
+        /** Occurrence of a section in the buffer of a lazily loaded file,
+          * which starts at its header line. */
+        struct SectionRange
+        {
+            const char *begin;
+            const char *end;
+            int lineNo;
+        };
+
+        using SectionIndex = typename Storage::template container<string_type,
+            std::vector<SectionRange>,
+            Comparator,
+            Allocator>;
+
+#ifdef INICPP_HAS_THREADS
+        /** Serializes the decoding of lazily loaded sections through const
+          * access. The flag is set while sections may be pending, so files
+          * which are decoded completely are read without locking. Copies
+          * get a mutex of their own. */
+        class LazyLock
+        {
+        public:
+            std::mutex mutex;
+            std::atomic<bool> pending;
+
+            LazyLock() : pending(false)
+            {}
+
+            LazyLock(const LazyLock &other) : pending(other.pending.load(std::memory_order_acquire))
+            {}
+
+            LazyLock &operator=(const LazyLock &other)
+            {
+                pending.store(other.pending.load(std::memory_order_acquire), std::memory_order_release);
+                return *this;
+            }
+        };
+#endif
+
+        IniParser parser_;
+        bool overwriteDuplicateFields_ = true;
+        bool lazyLoad_ = false;
+        LoadMode loadMode_ = LoadMode::Stream;
+        // sections of a lazily loaded file which were not decoded yet
+        SectionIndex lazySections_;
+        // contents of a lazily loaded file, shared by all of its copies
+        std::shared_ptr<const FileBuffer> lazyBuffer_;
+#ifdef INICPP_HAS_THREADS
+        mutable LazyLock lazyLock_;
+#endif
+#ifdef INICPP_HAS_THREADS
+        // decodes large buffers in parallel if set
+        std::shared_ptr<ThreadPool> threadPool_;
+        std::size_t minChunkSize_ = 1024 * 1024;
+#endif
+#ifdef INICPP_HAS_STATS
+        // receives the statistics of each decode and encode if set
+        std::shared_ptr<IniObserver> observer_;
+#endif
+
+        /** Stores the events of the parser as sections and fields of a file. */
+        class DecodeHandler : public IniHandler
+        {
+        protected:
+            IniFileBase &file_;
+            section_type *section_ = nullptr;
+
+        private:
+            const allocator_type alloc_;
+            // number of lines which precede the parsed range
+            const int lineOffset_;
+
+        public:
+            explicit DecodeHandler(IniFileBase &file, const int lineOffset = 0)
+                : file_(file), alloc_(file.get_allocator()), lineOffset_(lineOffset)
+            {}
+
+            bool onSection(const StringView name, const int)
+            {
+                section_ = &static_cast<Base &>(file_)[string_type(name.data(), name.size(), alloc_)];
+                return true;
+            }
+
+            bool onField(const StringView name, const StringView value, const int lineNo)
+            {
+                // the name is moved into the section, if it is new
+                auto inserted = section_->try_emplace(string_type(name.data(), name.size(), alloc_));
+                if(!file_.overwriteDuplicateFields_ && !inserted.second)
+                    throwParseError(lineOffset_ + lineNo, "duplicate field found");
+
+                inserted.first->second.buffer().assign(value.data(), value.size());
+                return true;
+            }
+
+            bool onError(const StringView msg, const int lineNo)
+            {
+                throwParseError(lineOffset_ + lineNo, std::string(msg.data(), msg.size()));
+                return false;
+            }
+        };
+
+#ifdef INICPP_HAS_STATS
+        /** Stores the events of the parser like DecodeHandler and counts the
+          * created sections and fields, the overwritten fields and the
+          * comments. Reading the clock costs about as much as inserting a
+          * short field, so only the first inserts and every eighth after them
+          * are timed. The time of the other inserts is extrapolated. */
+        class StatsHandler : public DecodeHandler
+        {
+        private:
+            IniStats &stats_;
+            const std::chrono::nanoseconds insertTime_;
+            std::chrono::nanoseconds timedTime_ = std::chrono::nanoseconds(0);
+            std::size_t inserts_ = 0;
+            std::size_t timedInserts_ = 0;
+
+            template<typename Insert>
+            void timeInsert(Insert insert)
+            {
+                if(inserts_ < 64 || inserts_ % 8 == 0)
+                {
+                    {
+                        IniStatsTimer timer(&timedTime_);
+                        insert();
+                    }
+                    ++timedInserts_;
+                }
+                else
+                {
+                    insert();
+                }
+                ++inserts_;
+                const std::chrono::nanoseconds::rep untimed =
+                    static_cast<std::chrono::nanoseconds::rep>(inserts_ - timedInserts_);
+                const std::chrono::nanoseconds::rep timed = static_cast<std::chrono::nanoseconds::rep>(timedInserts_);
+                stats_.insertTime = insertTime_ + timedTime_ + timedTime_ * untimed / timed;
+            }
+
+        public:
+            StatsHandler(IniFileBase &file, IniStats &stats, const int lineOffset = 0)
+                : DecodeHandler(file, lineOffset), stats_(stats), insertTime_(stats.insertTime)
+            {}
+
+            bool onSection(const StringView name, const int lineNo)
+            {
+                const std::size_t count = static_cast<Base &>(this->file_).size();
+                timeInsert([&]() { DecodeHandler::onSection(name, lineNo); });
+                stats_.sections += static_cast<Base &>(this->file_).size() - count;
+                return true;
+            }
+
+            bool onField(const StringView name, const StringView value, const int lineNo)
+            {
+                const std::size_t count = this->section_->size();
+                timeInsert([&]() { DecodeHandler::onField(name, value, lineNo); });
+                if(this->section_->size() != count)
+                    ++stats_.fields;
+                else
+                    ++stats_.duplicates;
+                return true;
+            }
+
+            bool onComment(const StringView, const int)
+            {
+                ++stats_.comments;
+                return true;
+            }
+        };
+#endif
+
+#ifdef INICPP_HAS_THREADS
+        /** Throws the duplicate field error for the first field which is
+          * contained in the given file of known fields. */
+        class DuplicateHandler : public IniHandler
+        {
+        private:
+            Base &known_;
+            const int lineOffset_;
+            section_type *section_ = nullptr;
+
+        public:
+            DuplicateHandler(Base &known, const int lineOffset) : known_(known), lineOffset_(lineOffset)
+            {}
+
+            bool onSection(const StringView name, const int)
+            {
+                auto it = known_.find(string_type(name.data(), name.size(), allocator_type(known_.get_allocator())));
+                section_ = it != known_.end() ? &it->second : nullptr;
+                return true;
+            }
+
+            bool onField(const StringView name, const StringView, const int lineNo)
+            {
+                if(section_ != nullptr &&
+                    section_->find(string_type(name.data(), name.size(), allocator_type(known_.get_allocator()))) !=
+                        section_->end())
+                    throwParseError(lineOffset_ + lineNo, "duplicate field found");
+                return true;
+            }
+        };
+#endif
+
+        /** Registers a section header of a lazily loaded file in the index
+          * without decoding any fields. */
+        class IndexHandler : public IniHandler
+        {
+        private:
+            IniFileBase &file_;
+            const int lineNo_;
+            std::vector<SectionRange> *ranges_ = nullptr;
+
+        public:
+            IndexHandler(IniFileBase &file, const int lineNo) : file_(file), lineNo_(lineNo)
+            {}
+
+            std::vector<SectionRange> *ranges() const
+            {
+                return ranges_;
+            }
+
+            bool onSection(const StringView name, const int)
+            {
+                string_type key(name.data(), name.size(), allocator_type(file_.get_allocator()));
+                static_cast<Base &>(file_)[key];
+                ranges_ = &file_.lazySections_[std::move(key)];
+                return true;
+            }
+
+            bool onError(const StringView msg, const int)
+            {
+                throwParseError(lineNo_, std::string(msg.data(), msg.size()));
+                return false;
+            }
+        };
+
+        /** Finds the section headers of the given buffer and decodes only
+          * the lines before the first one. The sections are inserted empty and
+          * their occurrences are recorded in the index. */
+        void indexSections(const char *data, const std::size_t size)
+        {
+            this->clear();
+            const char *const dataEnd = data + size;
+            const char *pos = data;
+            std::vector<SectionRange> *ranges = nullptr;
+            int lineNo = 0;
+            while(pos != dataEnd)
+            {
+                const char *line = pos;
+                const char *lineEnd = static_cast<const char *>(
+                    std::memchr(pos, '\n', static_cast<std::size_t>(dataEnd - pos)));
+                if(lineEnd == nullptr)
+                    lineEnd = dataEnd;
+                pos = lineEnd == dataEnd ? dataEnd : lineEnd + 1;
+                ++lineNo;
+
+                const char *first = line;
+                while(first != lineEnd && IniParser::isWhitespace(*first))
+                    ++first;
+                if(first == lineEnd || *first != '[')
+                    continue;
+
+                if(ranges != nullptr)
+                {
+                    ranges->back().end = line;
+                }
+                else
+                {
+                    DecodeHandler handler(*this);
+                    parser_.parse(data, static_cast<std::size_t>(line - data), handler);
+                }
+
+                IndexHandler handler(*this, lineNo);
+                parser_.parse(line, static_cast<std::size_t>(lineEnd - line), handler);
+                ranges = handler.ranges();
+                ranges->push_back(SectionRange{line, dataEnd, lineNo});
+            }
+
+            if(ranges == nullptr)
+            {
+                DecodeHandler handler(*this);
+                parser_.parse(data, size, handler);
+            }
+            setLazySectionsPending(!lazySections_.empty());
+        }
+
+        /** Decodes all occurrences of an indexed section in document order. */
+        void decodeRanges(const std::vector<SectionRange> &ranges)
+        {
+#ifdef INICPP_HAS_STATS
+            if(observer_ != nullptr)
+            {
+                IniStatsScope scope(*observer_);
+                for(const SectionRange &range : ranges)
+                {
+                    StatsHandler handler(*this, scope.stats(), range.lineNo - 1);
+                    parser_.parse(range.begin, static_cast<std::size_t>(range.end - range.begin), handler, scope.stats());
+                }
+                scope.finishDecode();
+                return;
+            }
+#endif
+            for(const SectionRange &range : ranges)
+            {
+                DecodeHandler handler(*this, range.lineNo - 1);
+                parser_.parse(range.begin, static_cast<std::size_t>(range.end - range.begin), handler);
+            }
+        }
+
+        /** Returns true if sections of a lazily loaded file may not have
+          * been decoded yet. */
+        bool lazySectionsPending() const
+        {
+#ifdef INICPP_HAS_THREADS
+            return lazyLock_.pending.load(std::memory_order_acquire);
+#else
+            return !lazySections_.empty();
+#endif
+        }
+
+        /** Marks whether sections of a lazily loaded file are pending. */
+        void setLazySectionsPending(const bool pending)
+        {
+#ifdef INICPP_HAS_THREADS
+            lazyLock_.pending.store(pending, std::memory_order_release);
+#else
+            (void) pending;
+#endif
+        }
+
+        /** Decodes the indexed section at the given position of the index and
+          * removes it from the index. If the section fails to decode, its
+          * fields are removed again and it stays in the index, so the error
+          * is thrown again on the next access. */
+        void decodeIndexedSection(const typename SectionIndex::iterator it)
+        {
+            try
+            {
+                decodeRanges(it->second);
+            }
+            catch(...)
+            {
+                const auto section = Base::find(it->first);
+                if(section != Base::end())
+                    section->second.clear();
+                throw;
+            }
+            lazySections_.erase(it);
+            if(lazySections_.empty())
+            {
+                lazyBuffer_.reset();
+                setLazySectionsPending(false);
+            }
+        }
+
+        /** Decodes the section with the given name if it was not decoded
+          * yet. Decoding a section of a lazily loaded file changes the
+          * contents of the file, even if it is accessed as const, so it is
+          * serialized by a lock. */
+        template<typename K>
+        void decodeLazySection(const K &name) const
+        {
+            if(!lazySectionsPending())
+                return;
+
+#ifdef INICPP_HAS_THREADS
+            std::lock_guard<std::mutex> lock(lazyLock_.mutex);
+#endif
+            IniFileBase &self = const_cast<IniFileBase &>(*this);
+            const auto it = self.lazySections_.find(name);
+            if(it != self.lazySections_.end())
+                self.decodeIndexedSection(it);
+        }
+
+        /** Decodes all sections which were not decoded yet. */
+        void decodeLazySections() const
+        {
+            if(!lazySectionsPending())
+                return;
+
+#ifdef INICPP_HAS_THREADS
+            std::lock_guard<std::mutex> lock(lazyLock_.mutex);
+#endif
+            IniFileBase &self = const_cast<IniFileBase &>(*this);
+            while(!self.lazySections_.empty())
+                self.decodeIndexedSection(self.lazySections_.begin());
+        }
+
+#ifdef INICPP_HAS_THREADS
+        /** Returns the start of the first section header line in [pos, end)
+          * or end if there is none. pos has to be the start of a line. */
+        static const char *findSectionStart(const char *pos, const char *end)
+        {
+            while(pos != end)
+            {
+                const char *first = pos;
+                while(first != end && *first != '\n' && IniParser::isWhitespace(*first))
+                    ++first;
+                if(first != end && *first == '[')
+                    return pos;
+                pos = static_cast<const char *>(std::memchr(first, '\n', static_cast<std::size_t>(end - first)));
+                if(pos == nullptr)
+                    return end;
+                ++pos;
+            }
+            return end;
+        }
+
+        /** Creates an empty file with the format and the allocator of this file. */
+        IniFileBase makeChunkFile() const
+        {
+            IniFileBase file{allocator_type(this->get_allocator())};
+            file.parser_ = parser_;
+            file.overwriteDuplicateFields_ = overwriteDuplicateFields_;
+            return file;
+        }
+
+        /** Moves the sections and fields of a decoded chunk into this file.
+          * Fields which already exist are overwritten or, if overwriting is
+          * not allowed, collected as duplicates. */
+        void mergeChunk(IniFileBase &chunk, std::vector<std::pair<string_type, string_type>> &duplicates)
+        {
+            Base &chunkBase = chunk;
+            if(Base::empty())
+            {
+                Base::operator=(std::move(chunkBase));
+                return;
+            }
+
+            for(auto &sectionPair : chunkBase)
+            {
+                auto inserted = Base::try_emplace(sectionPair.first, std::move(sectionPair.second));
+                if(inserted.second)
+                    continue;
+
+                section_type &section = inserted.first->second;
+                for(auto &fieldPair : sectionPair.second)
+                {
+                    auto field = section.try_emplace(fieldPair.first, std::move(fieldPair.second));
+                    if(field.second)
+                        continue;
+                    if(overwriteDuplicateFields_)
+                        field.first->second = std::move(fieldPair.second);
+                    else
+                        duplicates.emplace_back(sectionPair.first, fieldPair.first);
+                }
+            }
+        }
+
+        /** Throws the parse error of a chunk with the line number it has in
+          * the whole buffer by decoding the chunk once more. */
+        void throwChunkError(const char *data, const char *begin, const char *end) const
+        {
+            const int lineOffset = static_cast<int>(std::count(data, begin, '\n'));
+            IniFileBase chunk = makeChunkFile();
+            DecodeHandler handler(chunk, lineOffset);
+            parser_.parse(begin, static_cast<std::size_t>(end - begin), handler);
+        }
+
+        /** Throws the duplicate field error for the first field of a chunk
+          * which already existed in a previous chunk. */
+        void throwDuplicateError(const char *data,
+            const char *begin,
+            const char *end,
+            const std::vector<std::pair<string_type, string_type>> &duplicates) const
+        {
+            // collect the duplicates in a file, so they are compared like
+            // the sections and fields of this file
+            IniFileBase known = makeChunkFile();
+            for(const auto &duplicate : duplicates)
+                static_cast<Base &>(known)[duplicate.first][duplicate.second];
+
+            DuplicateHandler handler(known, static_cast<int>(std::count(data, begin, '\n')));
+            parser_.parse(begin, static_cast<std::size_t>(end - begin), handler);
+        }
+
+        /** Returns true if a buffer of the given size is decoded on the
+          * thread pool. */
+        bool decodesInParallel(const std::size_t size) const
+        {
+            return threadPool_ != nullptr && threadPool_->size() > 1 && size / minChunkSize_ >= 2;
+        }
+
+        /** Splits the buffer into chunks at section headers, decodes the
+          * chunks on the thread pool and merges them in document order. */
+#ifdef INICPP_HAS_STATS
+        void decodeParallel(const char *data, const std::size_t size, IniStats *stats = nullptr)
+#else
+        void decodeParallel(const char *data, const std::size_t size)
+#endif
+        {
+            const char *const dataEnd = data + size;
+            const std::size_t chunkCount = std::min(threadPool_->size() * 4, size / minChunkSize_);
+            std::vector<const char *> bounds(1, data);
+            for(std::size_t i = 1; i < chunkCount; ++i)
+            {
+                const char *pos = data + size / chunkCount * i;
+                if(pos <= bounds.back())
+                    continue;
+                // continue at the start of the next line
+                if(*(pos - 1) != '\n')
+                {
+                    pos = static_cast<const char *>(std::memchr(pos, '\n', static_cast<std::size_t>(dataEnd - pos)));
+                    if(pos == nullptr)
+                        break;
+                    ++pos;
+                }
+                pos = findSectionStart(pos, dataEnd);
+                if(pos == dataEnd)
+                    break;
+                if(pos != bounds.back())
+                    bounds.push_back(pos);
+            }
+            bounds.push_back(dataEnd);
+
+            const std::size_t chunks = bounds.size() - 1;
+            std::vector<IniFileBase> files;
+            files.reserve(chunks);
+            for(std::size_t i = 0; i < chunks; ++i)
+                files.push_back(makeChunkFile());
+            std::unique_ptr<bool[]> failed(new bool[chunks]());
+#ifdef INICPP_HAS_STATS
+            std::vector<IniStats> chunkStats(stats != nullptr ? chunks : 0);
+#endif
+            threadPool_->run(chunks, [&](const std::size_t i) {
+                try
+                {
+#ifdef INICPP_HAS_STATS
+                    if(stats != nullptr)
+                    {
+                        StatsHandler handler(files[i], chunkStats[i]);
+                        parser_.parse(
+                            bounds[i], static_cast<std::size_t>(bounds[i + 1] - bounds[i]), handler, chunkStats[i]);
+                        return;
+                    }
+#endif
+                    DecodeHandler handler(files[i]);
+                    parser_.parse(bounds[i], static_cast<std::size_t>(bounds[i + 1] - bounds[i]), handler);
+                }
+                catch(const std::logic_error &)
+                {
+                    // rethrown in document order with the correct line number
+                    failed[i] = true;
+                }
+            });
+
+            std::vector<std::pair<string_type, string_type>> duplicates;
+            {
+#ifdef INICPP_HAS_STATS
+                IniStatsTimer timer(stats != nullptr ? &stats->insertTime : nullptr);
+#endif
+                for(std::size_t i = 0; i < chunks; ++i)
+                {
+                    mergeChunk(files[i], duplicates);
+                    if(!duplicates.empty())
+                        throwDuplicateError(data, bounds[i], bounds[i + 1], duplicates);
+                    if(failed[i])
+                        throwChunkError(data, bounds[i], bounds[i + 1]);
+                }
+            }
+
+#ifdef INICPP_HAS_STATS
+            if(stats != nullptr)
+            {
+                // each chunk was decoded into an empty file, so every field
+                // of a chunk which is missing in the merged file overwrote a
+                // field of a previous chunk
+                IniStats merged;
+                for(const IniStats &chunk : chunkStats)
+                    merged += chunk;
+                const std::size_t fields = merged.fields;
+                merged.sections = Base::size();
+                merged.fields = 0;
+                for(const auto &section : static_cast<const Base &>(*this))
+                    merged.fields += section.second.size();
+                merged.duplicates += fields - merged.fields;
+                *stats += merged;
+            }
+#endif
+        }
+#endif
+
+#ifdef INICPP_HAS_STATS
+        /** Decodes the given buffer into this empty file and adds the
+          * statistics of the decode. */
+        void decodeObserved(const char *data, const std::size_t size, IniStats &stats)
+        {
+#ifdef INICPP_HAS_THREADS
+            if(decodesInParallel(size))
+            {
+                decodeParallel(data, size, &stats);
+                return;
+            }
+#endif
+            StatsHandler handler(*this, stats);
+            parser_.parse(data, size, handler, stats);
+        }
+
+        /** Loads the file at the given path and reports the statistics of the
+          * load. A lazily loaded file only reports the bytes and sections of
+          * the file and the time spent reading and indexing it. */
+        void loadObserved(const std::string &fileName)
+        {
+            IniStatsScope scope(*observer_);
+            IniStats &stats = scope.stats();
+            std::shared_ptr<const FileBuffer> buffer;
+            {
+                IniStatsTimer timer(&stats.readTime);
+                buffer = std::make_shared<FileBuffer>(fileName, loadMode_);
+            }
+
+            if(lazyLoad_)
+            {
+                {
+                    IniStatsTimer timer(&stats.tokenizeTime);
+                    indexSections(buffer->data(), buffer->size());
+                }
+                stats.bytes = buffer->size();
+                stats.sections = Base::size();
+                if(!lazySections_.empty())
+                    lazyBuffer_ = std::move(buffer);
+            }
+            else
+            {
+                this->clear();
+                decodeObserved(buffer->data(), buffer->size(), stats);
+            }
+            scope.finishDecode();
+        }
+
+        /** Encodes this file and reports the statistics of the encode. Sections
+          * of a lazily loaded file which were not decoded yet are reported as
+          * decodes of their own. */
+        void encodeObserved(std::ostream &os) const
+        {
+            decodeLazySections();
+            IniStatsScope scope(*observer_);
+            IniStats &stats = scope.stats();
+            {
+                IniStatsTimer timer(&stats.convertTime);
+                stats.bytes = encodeSections(os);
+            }
+
+            std::size_t newlines = 0;
+            for(const auto &section : static_cast<const Base &>(*this))
+            {
+                ++stats.sections;
+                stats.fields += section.second.size();
+                for(const auto &field : section.second)
+                    newlines += static_cast<std::size_t>(
+                        std::count(field.second.value_.begin(), field.second.value_.end(), '\n'));
+            }
+            // each section is written as header and empty line
+            stats.lines = 2 * stats.sections + stats.fields + newlines;
+            if(parser_.multiLineValues())
+                stats.continuations = newlines;
+            scope.finishEncode();
+        }
+#endif
+
+        /** Writes all sections of this file to the given stream.
+          * @return number of characters written. */
+        std::size_t encodeSections(std::ostream &os) const
+        {
+            std::size_t written = 0;
+            // iterate through all sections in this file
+            for(const auto &filePair : *this)
+            {
+                os.put('[');
+                written += parser_.writeEscaped(os, filePair.first);
+                os.put(']');
+                os.put('\n');
+
+                // iterate through all fields in the section
+                for(const auto &secPair : filePair.second)
+                {
+                    written += parser_.writeEscaped(os, secPair.first);
+                    os.put(parser_.fieldSep());
+                    written += parser_.writeEscaped(os, secPair.second.value_);
+                    os.put('\n');
+                    written += 2;
+                }
+
+                // Add a newline after each section
+                os.put('\n');
+                written += 4;
+            }
+            return written;
+        }
+
+
+    public:
+        IniFileBase() = default;
+
+        /** Creates an empty ini file whose sections and fields are allocated
+          * with the given allocator. */
+        explicit IniFileBase(const allocator_type &alloc)
+            : Base(typename Base::allocator_type(alloc)), lazySections_(typename SectionIndex::allocator_type(alloc))
+        {}
+
+        IniFileBase(const char fieldSep, const char comment)
+            : parser_(fieldSep, std::vector<std::string>(1, std::string(1, comment)))
+        {}
+
+        IniFileBase(const std::string &filename)
+        {
+            load(filename);
+        }
+
+        IniFileBase(std::istream &is)
+        {
+            decode(is);
+        }
+
+        IniFileBase(const char fieldSep,
+            const std::vector<std::string> &commentPrefixes)
+            : parser_(fieldSep, commentPrefixes)
+        {}
+
+        IniFileBase(const std::string &filename,
+            const char fieldSep,
+            const std::vector<std::string> &commentPrefixes)
+            : parser_(fieldSep, commentPrefixes)
+        {
+            load(filename);
+        }
+
+        IniFileBase(std::istream &is,
+            const char fieldSep,
+            const std::vector<std::string> &commentPrefixes)
+            : parser_(fieldSep, commentPrefixes)
+        {
+            decode(is);
+        }
+
+        /** Sets the separator charactor for fields in the INI file.
+          * @param sep separator character to be used. */
+        void setFieldSep(const char sep)
+        {
+            parser_.setFieldSep(sep);
+        }
+
+        /** Sets the character that should be interpreted as the start of comments.
+          * Default is '#'.
+          * Note: If the inifile contains the comment character as data it must be prefixed with
+          * the configured escape character.
+          * @param comment comment character to be used. */
+        void setCommentChar(const char comment)
+        {
+            setCommentPrefixes({std::string(1, comment)});
+        }
+
+        /** Sets the list of strings that should be interpreted as the start of comments.
+          * Default is [ "#" ].
+          * Note: If the inifile contains any comment string as data it must be prefixed with
+          * the configured escape character.
+          * @param commentPrefixes vector of comment prefix strings to be used. */
+        void setCommentPrefixes(const std::vector<std::string> &commentPrefixes)
+        {
+            parser_.setCommentPrefixes(commentPrefixes);
+        }
+
+        /** Sets the character that should be used to escape comment prefixes.
+          * Default is '\'.
+          * @param esc escape character to be used. */
+        void setEscapeChar(const char esc)
+        {
+            parser_.setEscapeChar(esc);
+        }
+
+        /** Sets whether or not to parse multi-line field values.
+          * Default is false.
+          * @param enable enable or disable? */
+        void setMultiLineValues(bool enable)
+        {
+            parser_.setMultiLineValues(enable);
+        }
+
+        /** Sets whether or not overwriting duplicate fields is allowed.
+          * If overwriting duplicate fields is not allowed,
+          * an exception is thrown when a duplicate field is found inside a section.
+          * Default is true.
+          * @param allowed Is overwriting duplicate fields allowed or not? */
+        void allowOverwriteDuplicateFields(bool allowed)
+        {
+            overwriteDuplicateFields_ = allowed;
+        }
+
+        /** Sets the instruction set used to scan the input while decoding.
+          * Default is the fastest kernel supported by the CPU.
+          * @param kernel kernel to be used, falls back to ScanKernel::Scalar
+          *        if the CPU does not support it. */
+        void setScanKernel(const ScanKernel kernel)
+        {
+            parser_.setScanKernel(kernel);
+        }
+
+        /** Sets how files are read by load(). A memory mapped file must not
+          * be truncated while it is mapped, otherwise reading it raises
+          * SIGBUS instead of an exception.
+          * Default is LoadMode::Stream.
+          * @param mode strategy used to read files. */
+        void setLoadMode(const LoadMode mode)
+        {
+            loadMode_ = mode;
+        }
+
+        /** Sets whether load() decodes sections on first access.
+          * If enabled, load() only indexes the section headers of the file
+          * and keeps its contents in memory. The fields of a section are
+          * decoded when it is accessed through operator[], at() or find(),
+          * all remaining sections are decoded by begin(), erase() and
+          * decodeAll(). get() and getOr() decode sections like at().
+          * Parse errors within a section are thrown on every access, the
+          * section stays empty until it decodes. Const access decodes
+          * sections under a lock, so concurrent const readers are safe
+          * unless INICPP_NO_THREADS is defined. Non-const access must not
+          * run concurrently. A memory mapped file must not change until all
+          * of its sections are decoded.
+          * Default is false.
+          * @param enable enable or disable? */
+        void setLazyLoad(const bool enable)
+        {
+            lazyLoad_ = enable;
+        }
+
+#ifdef INICPP_HAS_THREADS
+        /** Sets the thread pool which decodes large buffers in parallel.
+          * Buffers of at least two chunks are split at section headers into
+          * up to four chunks per thread. The chunks are decoded concurrently
+          * and merged in document order, so repeated sections, duplicate
+          * fields and the line numbers of errors behave exactly like a
+          * sequential decode. The allocator of the file is used by several
+          * threads at once. Default is no thread pool.
+          * @param pool thread pool to be used, nullptr decodes sequentially.
+          * @param minChunkSize minimum number of bytes per chunk. */
+        void setThreadPool(std::shared_ptr<ThreadPool> pool, const std::size_t minChunkSize = 1024 * 1024)
+        {
+            threadPool_ = std::move(pool);
+            minChunkSize_ = std::max<std::size_t>(minChunkSize, 1);
+        }
+#endif
+
+#ifdef INICPP_HAS_STATS
+        /** Sets the observer which receives the statistics of each decode and
+          * encode of this file, e.g. to export them to a metrics system.
+          * Copies of the file share the observer. Without an observer the
+          * file is decoded and encoded exactly like without statistics.
+          * Default is no observer.
+          * @param observer observer to be used, nullptr disables statistics. */
+        void setObserver(std::shared_ptr<IniObserver> observer)
+        {
+            observer_ = std::move(observer);
+        }
+
+        const std::shared_ptr<IniObserver> &observer() const
+        {
+            return observer_;
+        }
+#endif
+
+        /** Returns the number of sections which were not decoded yet. */
+        std::size_t lazySectionCount() const
+        {
+            return lazySections_.size();
+        }
+
+        /** Decodes all sections of a lazily loaded file which were not
+          * decoded yet. Afterwards const access does not change the file
+          * anymore, so it can be shared between threads. */
+        void decodeAll()
+        {
+            decodeLazySections();
+        }
+
+        /** Returns the section with the given name or nullptr if it does not
+          * exist. No key is built (except for long names in std::map on
+          * C++11) and the file is never changed, except that a section of a
+          * lazily loaded file is decoded on its first access under a lock,
+          * so concurrent readers need no locking. */
+        const section_type *get(const StringView name) const
+        {
+            decodeLazySection(name);
+            const auto it = Base::find(name);
+            return it != Base::end() ? &it->second : nullptr;
+        }
+
+        /** Returns the field with the given name in the given section or
+          * nullptr if it does not exist. */
+        const field_type *get(const StringView section, const StringView name) const
+        {
+            const section_type *sec = get(section);
+            return sec != nullptr ? sec->get(name) : nullptr;
+        }
+
+        /** Returns the value of the given field converted to T or the default
+          * value if the section or the field does not exist.
+          * @throws std::invalid_argument if the value cannot be converted. */
+        template<typename T>
+        T getOr(const StringView section, const StringView name, const T &defaultValue) const
+        {
+            const field_type *field = get(section, name);
+            return field != nullptr ? field->template as<T>() : defaultValue;
+        }
+
+        std::string getOr(const StringView section, const StringView name, const char *defaultValue) const
+        {
+            return getOr<std::string>(section, name, std::string(defaultValue));
+        }
+
+        /** Accesses the section with the given name and inserts it if it
+          * does not exist. */
+        template<typename K>
+        section_type &operator[](K &&name)
+        {
+            decodeLazySection(name);
+            return Base::operator[](std::forward<K>(name));
+        }
+
+        /** Accesses the section with the given name.
+          * @throws std::out_of_range if the section does not exist. */
+        template<typename K>
+        section_type &at(const K &name)
+        {
+            decodeLazySection(name);
+            return Base::at(name);
+        }
+
+        template<typename K>
+        const section_type &at(const K &name) const
+        {
+            decodeLazySection(name);
+            return Base::at(name);
+        }
+
+        template<typename K>
+        typename Base::iterator find(const K &name)
+        {
+            decodeLazySection(name);
+            return Base::find(name);
+        }
+
+        template<typename K>
+        typename Base::const_iterator find(const K &name) const
+        {
+            decodeLazySection(name);
+            return Base::find(name);
+        }
+
+        typename Base::iterator begin()
+        {
+            decodeLazySections();
+            return Base::begin();
+        }
+
+        typename Base::const_iterator begin() const
+        {
+            decodeLazySections();
+            return Base::begin();
+        }
+
+        typename Base::const_iterator cbegin() const
+        {
+            decodeLazySections();
+            return Base::cbegin();
+        }
+
+        template<typename... Args>
+        auto erase(Args &&...args) -> decltype(std::declval<Base &>().erase(std::forward<Args>(args)...))
+        {
+            decodeLazySections();
+            return Base::erase(std::forward<Args>(args)...);
+        }
+
+        /** Removes all sections. */
+        void clear()
+        {
+            Base::clear();
+            lazySections_.clear();
+            lazyBuffer_.reset();
+            setLazySectionsPending(false);
+        }
+
+        /** Returns the parser which decodes this file. It can be used to
+          * parse documents of the same format with a custom IniHandler. */
+        const IniParser &parser() const
+        {
+            return parser_;
+        }
+
+        /** Tries to decode a ini file from the given character buffer.
+          * The buffer is tokenized in place, memory is only allocated to store
+          * the resulting section names, field names and values.
+          * @param data pointer to the ini data to be decoded.
+          * @param size number of characters in the buffer. */
+        void decode(const char *data, const std::size_t size)
+        {
+            this->clear();
+#ifdef INICPP_HAS_STATS
+            if(observer_ != nullptr)
+            {
+                IniStatsScope scope(*observer_);
+                decodeObserved(data, size, scope.stats());
+                scope.finishDecode();
+                return;
+            }
+#endif
+#ifdef INICPP_HAS_THREADS
+            if(decodesInParallel(size))
+            {
+                decodeParallel(data, size);
+                return;
+            }
+#endif
+            DecodeHandler handler(*this);
+            parser_.parse(data, size, handler);
+        }
+
+        /** Tries to decode a ini file from the given null-terminated string.
+          * @param content string to be decoded. */
+        void decode(const char *content)
+        {
+            decode(content, std::strlen(content));
+        }
+
+        /** Tries to decode a ini file from the given input string.
+          * @param content string to be decoded. */
+        void decode(const std::string &content)
+        {
+            decode(content.data(), content.size());
+        }
+
+#ifdef __cpp_lib_string_view
+        /** Tries to decode a ini file from the given string view.
+          * @param content string to be decoded. */
+        void decode(std::string_view content)
+        {
+            decode(content.data(), content.size());
+        }
+#endif
+
+        /** Tries to decode a ini file from the given input stream.
+          * The stream is decoded block by block, it is never held in memory
+          * as a whole.
+          * @param is input stream from which data should be read. */
+        void decode(std::istream &is)
+        {
+            this->clear();
+#ifdef INICPP_HAS_STATS
+            if(observer_ != nullptr)
+            {
+                IniStatsScope scope(*observer_);
+                StatsHandler handler(*this, scope.stats());
+                parser_.parse(is, handler, scope.stats());
+                scope.finishDecode();
+                return;
+            }
+#endif
+            DecodeHandler handler(*this);
+            parser_.parse(is, handler);
+        }
+
+        /** Tries to load and decode a ini file from the file at the given path.
+          * If lazy loading is enabled, only the section headers are indexed,
+          * see setLazyLoad().
+          * @param fileName path to the file that should be loaded. */
+        void load(const std::string &fileName)
+        {
+#ifdef INICPP_HAS_STATS
+            if(observer_ != nullptr)
+            {
+                loadObserved(fileName);
+                return;
+            }
+#endif
+            if(lazyLoad_)
+            {
+                std::shared_ptr<const FileBuffer> buffer = std::make_shared<FileBuffer>(fileName, loadMode_);
+                indexSections(buffer->data(), buffer->size());
+                if(!lazySections_.empty())
+                    lazyBuffer_ = std::move(buffer);
+                return;
+            }
+
+            FileBuffer buffer(fileName, loadMode_);
+            decode(buffer.data(), buffer.size());
+        }
+
+        /** Encodes this inifile object and writes the output to the given stream.
+          * @param os target stream. */
+        void encode(std::ostream &os) const
+        {
+#ifdef INICPP_HAS_STATS
+            if(observer_ != nullptr)
+            {
+                encodeObserved(os);
+                return;
+            }
+#endif
+            encodeSections(os);
+        }
+
+        /** Encodes this inifile object as string and returns the result.
+          * @return encoded infile string. */
+        std::string encode() const
+        {
+            std::ostringstream ss;
+            encode(ss);
+            return ss.str();
+        }
+
+        /** Saves this inifile object to the file at the given path.
+          * @param fileName path to the file where the data should be stored. */
+        void save(const std::string &fileName) const
+        {
+            std::ofstream os(fileName.c_str());
+            encode(os);
+        }
+
+        /** Encodes this inifile object as binary ini file, which can be
+          * queried in place by IniBinaryView or IniBinaryFile without parsing.
+          * Names are matched ignoring case in the binary file if the
+          * comparator of this file is case insensitive and exactly otherwise.
+          * @param out string which receives the binary ini file.
+          * @throws std::length_error if the binary file would exceed 4GB. */
+        void encodeBinary(std::string &out) const
+        {
+            IniBinaryWriter writer;
+            for(const auto &filePair : *this)
+            {
+                writer.addSection(StringView(filePair.first.data(), filePair.first.size()));
+                for(const auto &secPair : filePair.second)
+                {
+                    writer.addField(StringView(secPair.first.data(), secPair.first.size()),
+                        StringView(secPair.second.value_.data(), secPair.second.value_.size()));
+                }
+            }
+            writer.write(out, IsCaseInsensitive<Comparator>::value);
+        }
+
+        /** Encodes this inifile object as binary ini file and returns it. */
+        std::string encodeBinary() const
+        {
+            std::string result;
+            encodeBinary(result);
+            return result;
+        }
+
+        /** Saves this inifile object as binary ini file to the given path.
+          * @param fileName path to the file where the data should be stored. */
+        void saveBinary(const std::string &fileName) const
+        {
+            const std::string content = encodeBinary();
+            std::ofstream os(fileName.c_str(), std::ios::out | std::ios::binary);
+            os.write(content.data(), static_cast<std::streamsize>(content.size()));
+        }
+
+        /** Copies all sections and fields of the given binary ini file into
+          * this inifile object. Duplicate fields are handled as in decode().
+          * @param view binary ini file which should be decoded. */
+        void decodeBinary(const IniBinaryView &view)
+        {
+            this->clear();
+            DecodeHandler handler(*this);
+            for(const IniBinarySection &section : view)
+            {
+                handler.onSection(section.name(), 0);
+                for(const IniBinaryField &field : section)
+                    handler.onField(field.name(), field.str(), 0);
+            }
+        }
+
+        /** Loads the binary ini file at the given path into this inifile
+          * object.
+          * @param fileName path to the binary ini file.
+          * @throws std::invalid_argument if the file cannot be read or is not
+          *         a valid binary ini file. */
+        void loadBinary(const std::string &fileName)
+        {
+            IniBinaryFile file(fileName);
+            decodeBinary(file);
+        }
+    };
+
+    using IniFile = IniFileBase<std::less<std::string>>;
+    using IniSection = IniSectionBase<std::less<std::string>>;
+    using IniFileCaseInsensitive = IniFileBase<StringInsensitiveLess>;
+    using IniSectionCaseInsensitive = IniSectionBase<StringInsensitiveLess>;
+
+    /************************************************
+     * Schema Binding
+     ************************************************/
+
+    /** Section or field which was reported while binding a struct. The field
+      * is empty if the whole section is meant. */
+    struct IniBindIssue
+    {
+        std::string section;
+        std::string field;
+        // line of the ini file, 0 for missing fields
+        int lineNo;
+    };
+
+    /** Outcome of decoding an ini file into a struct. */
+    struct IniBindResult
+    {
+        /** Sections and fields of the ini file which are not in the schema.
+          * A section which is not in the schema is reported once, without
+          * its fields. */
+        std::vector<IniBindIssue> unknown;
+        /** Required fields of the schema which are not in the ini file. */
+        std::vector<IniBindIssue> missing;
+    };
+
+    /** Maps sections and fields of an ini file to the members of a struct.
+      * Ini files are decoded straight into the struct in a single pass, the
+      * values are converted by Convert<T> while parsing and no IniFile is
+      * ever built. Names are compared by the given comparator:
+      *
+      *     ini::IniSchema<Config> schema;
+      *     schema.required("Server", "host", &Config::host)
+      *         .optional("Server", "port", &Config::port, 8080);
+      *     Config config;
+      *     ini::IniBindResult result = schema.load("config.ini", config);
+      */
+    template<typename Struct, typename Comparator = std::less<std::string>>
+    class IniSchema
+    {
+    private:
+        using Less = typename TransparentComparator<Comparator>::type;
+
+        struct Binding
+        {
+            std::string section;
+            std::string name;
+            bool required;
+            std::function<void(Struct &, StringView)> decode;
+            std::function<void(const Struct &, std::string &)> encode;
+            // assigns the default value, empty if the field has none
+            std::function<void(Struct &)> assignDefault;
+        };
+
+        IniParser parser_;
+        // bindings in the order of declaration, which is kept when encoding
+        std::vector<Binding> bindings_;
+        // indices of the bindings sorted by section and field
+        std::vector<std::size_t> index_;
+
+        /** Reports the contents of an ini file to the bound members. */
+        class BindHandler : public IniHandler
+        {
+        private:
+            const IniSchema &schema_;
+            Struct &object_;
+            IniBindResult &result_;
+            std::vector<bool> &seen_;
+            std::vector<std::size_t>::const_iterator first_;
+            std::vector<std::size_t>::const_iterator last_;
+            bool knownSection_ = false;
+
+        public:
+            BindHandler(const IniSchema &schema, Struct &object, IniBindResult &result, std::vector<bool> &seen)
+                : schema_(schema), object_(object), result_(result), seen_(seen),
+                first_(schema.index_.end()), last_(schema.index_.end())
+            {}
+
+            bool onSection(const StringView name, const int lineNo)
+            {
+                const std::vector<Binding> &bindings = schema_.bindings_;
+                const Less less;
+                first_ = std::lower_bound(schema_.index_.begin(), schema_.index_.end(), name,
+                    [&](const std::size_t lhs, const StringView rhs) { return less(bindings[lhs].section, rhs); });
+                last_ = std::upper_bound(first_, schema_.index_.end(), name,
+                    [&](const StringView lhs, const std::size_t rhs) { return less(lhs, bindings[rhs].section); });
+                knownSection_ = first_ != last_;
+                if(!knownSection_)
+                    result_.unknown.push_back(IniBindIssue{std::string(name.data(), name.size()), std::string(), lineNo});
+                return true;
+            }
+
+            bool onField(const StringView name, const StringView value, const int lineNo)
+            {
+                if(!knownSection_)
+                    return true;
+
+                const std::vector<Binding> &bindings = schema_.bindings_;
+                const Less less;
+                const auto it = std::lower_bound(first_, last_, name,
+                    [&](const std::size_t lhs, const StringView rhs) { return less(bindings[lhs].name, rhs); });
+                if(it == last_ || less(name, bindings[*it].name))
+                {
+                    result_.unknown.push_back(IniBindIssue{
+                        bindings[*first_].section, std::string(name.data(), name.size()), lineNo});
+                    return true;
+                }
+
+                const Binding &binding = bindings[*it];
+                try
+                {
+                    binding.decode(object_, value);
+                }
+                catch(const std::out_of_range &e)
+                {
+                    throw std::out_of_range(errorMessage(binding, lineNo, e));
+                }
+                catch(const std::invalid_argument &e)
+                {
+                    throw std::invalid_argument(errorMessage(binding, lineNo, e));
+                }
+                seen_[*it] = true;
+                return true;
+            }
+
+            bool onError(const StringView msg, const int lineNo)
+            {
+                throwParseError(lineNo, std::string(msg.data(), msg.size()));
+                return false;
+            }
+
+            static std::string errorMessage(const Binding &binding, const int lineNo, const std::exception &e)
+            {
+                std::stringstream ss;
+                ss << "l." << lineNo << ": " << binding.section << '.' << binding.name << ": " << e.what();
+                return ss.str();
+            }
+        };
+
+        template<typename T>
+        IniSchema &bind(const StringView section,
+            const StringView name,
+            T Struct::*member,
+            const bool required,
+            std::function<void(Struct &)> assignDefault)
+        {
+            Binding binding;
+            binding.section.assign(section.data(), section.size());
+            binding.name.assign(name.data(), name.size());
+            binding.required = required;
+            binding.decode = [member](Struct &object, const StringView value) {
+                object.*member = convertRange<T>(value.data(), value.size());
+            };
+            binding.encode = [member](const Struct &object, std::string &result) {
+                Convert<T> conv;
+                conv.encode(object.*member, result);
+            };
+            binding.assignDefault = std::move(assignDefault);
+
+            const Less less;
+            const std::vector<Binding> &bindings = bindings_;
+            const auto pos = std::lower_bound(index_.begin(), index_.end(), binding,
+                [&](const std::size_t lhs, const Binding &rhs) {
+                    return less(bindings[lhs].section, rhs.section) ||
+                        (!less(rhs.section, bindings[lhs].section) && less(bindings[lhs].name, rhs.name));
+                });
+            if(pos != index_.end() && !less(binding.section, bindings_[*pos].section) &&
+                !less(binding.name, bindings_[*pos].name))
+                throw std::invalid_argument("field " + binding.section + '.' + binding.name + " is bound twice");
+
+            index_.insert(pos, bindings_.size());
+            bindings_.push_back(std::move(binding));
+            return *this;
+        }
+
+        void assignDefaults(Struct &object) const
+        {
+            for(const Binding &binding : bindings_)
+            {
+                if(binding.assignDefault)
+                    binding.assignDefault(object);
+            }
+        }
+
+        void collectMissing(const std::vector<bool> &seen, IniBindResult &result) const
+        {
+            for(std::size_t i = 0; i < bindings_.size(); ++i)
+            {
+                if(bindings_[i].required && !seen[i])
+                    result.missing.push_back(IniBindIssue{bindings_[i].section, bindings_[i].name, 0});
+            }
+        }
+
+    public:
+        explicit IniSchema(const IniParser &parser = IniParser()) : parser_(parser)
+        {}
+
+        /** Returns the parser which defines the syntax of decoded and encoded
+          * ini files. */
+        const IniParser &parser() const
+        {
+            return parser_;
+        }
+
+        void setParser(const IniParser &parser)
+        {
+            parser_ = parser;
+        }
+
+        /** Returns the number of bound fields. */
+        std::size_t size() const
+        {
+            return bindings_.size();
+        }
+
+        /** Binds a member to a field which has to be present in decoded files.
+          * @throws std::invalid_argument if the field is already bound. */
+        template<typename T>
+        IniSchema &required(const StringView section, const StringView name, T Struct::*member)
+        {
+            return bind(section, name, member, true, std::function<void(Struct &)>());
+        }
+
+        /** Binds a member to a field which may be missing in decoded files.
+          * The member keeps its value if the field is missing.
+          * @throws std::invalid_argument if the field is already bound. */
+        template<typename T>
+        IniSchema &optional(const StringView section, const StringView name, T Struct::*member)
+        {
+            return bind(section, name, member, false, std::function<void(Struct &)>());
+        }
+
+        /** Binds a member to a field which may be missing in decoded files.
+          * The member is set to the default value if the field is missing.
+          * @throws std::invalid_argument if the field is already bound. */
+        template<typename T, typename U>
+        IniSchema &optional(const StringView section, const StringView name, T Struct::*member, const U &defaultValue)
+        {
+            const T value(defaultValue);
+            return bind(section, name, member, false, [member, value](Struct &object) { object.*member = value; });
+        }
+
+        /** Decodes the given character buffer into the struct. Fields which
+          * are missing are set to their default values.
+          * @throws std::logic_error if the buffer is not a valid ini file.
+          * @throws std::invalid_argument, std::out_of_range if a value cannot
+          *         be converted to its member. */
+        IniBindResult decode(const char *data, const std::size_t size, Struct &object) const
+        {
+            IniBindResult result;
+            std::vector<bool> seen(bindings_.size(), false);
+            BindHandler handler(*this, object, result, seen);
+            assignDefaults(object);
+            parser_.parse(data, size, handler);
+            collectMissing(seen, result);
+            return result;
+        }
+
+        IniBindResult decode(const std::string &content, Struct &object) const
+        {
+            return decode(content.data(), content.size(), object);
+        }
+
+        /** Decodes the given stream block by block into the struct. */
+        IniBindResult decode(std::istream &is, Struct &object) const
+        {
+            IniBindResult result;
+            std::vector<bool> seen(bindings_.size(), false);
+            BindHandler handler(*this, object, result, seen);
+            assignDefaults(object);
+            parser_.parse(is, handler);
+            collectMissing(seen, result);
+            return result;
+        }
+
+        /** Loads the ini file at the given path into the struct. */
+        IniBindResult load(const std::string &fileName, Struct &object) const
+        {
+            FileBuffer buffer(fileName);
+            return decode(buffer.data(), buffer.size(), object);
+        }
+
+        /** Encodes the bound members of the struct. Sections and fields are
+          * written in the order in which they were bound. */
+        void encode(const Struct &object, std::ostream &os) const
+        {
+            std::vector<bool> written(bindings_.size(), false);
+            std::string value;
+            const Less less;
+            for(std::size_t i = 0; i < bindings_.size(); ++i)
+            {
+                if(written[i])
+                    continue;
+
+                const std::string &section = bindings_[i].section;
+                os.put('[');
+                parser_.writeEscaped(os, section);
+                os.put(']');
+                os.put('\n');
+                for(std::size_t j = i; j < bindings_.size(); ++j)
+                {
+                    const Binding &binding = bindings_[j];
+                    if(written[j] || less(section, binding.section) || less(binding.section, section))
+                        continue;
+                    binding.encode(object, value);
+                    parser_.writeEscaped(os, binding.name);
+                    os.put(parser_.fieldSep());
+                    parser_.writeEscaped(os, value);
+                    os.put('\n');
+                    written[j] = true;
+                }
+                os.put('\n');
+            }
+        }
+
+        std::string encode(const Struct &object) const
+        {
+            std::ostringstream ss;
+            encode(object, ss);
+            return ss.str();
+        }
+
+        /** Saves the bound members of the struct to the file at the given
+          * path. */
+        void save(const Struct &object, const std::string &fileName) const
+        {
+            std::ofstream os(fileName.c_str());
+            encode(object, os);
+        }
+    };
+
+    /************************************************
+     * Hot Reload
+     ************************************************/
+
+    /** Kind of a difference between two ini files. */
+    enum class ChangeType
+    {
+        Added,
+        Removed,
+        Changed
+    };
+
+    /** Single difference between two ini files. Changes of whole sections
+      * have an empty field name and are followed by the changes of all of
+      * their fields. */
+    struct IniChange
+    {
+        ChangeType type;
+        std::string section;
+        std::string field;
+        std::string oldValue;
+        std::string newValue;
+    };
+
+    using IniDiff = std::vector<IniChange>;
+
+    /** Computes the differences between two ini files. The changes of the
+      * sections of from are listed first in its order, followed by the
+      * sections which were added in to. */
+    template<typename Comparator, typename Storage, typename Allocator>
+    IniDiff diff(const IniFileBase<Comparator, Storage, Allocator> &from,
+        const IniFileBase<Comparator, Storage, Allocator> &to)
+    {
+        IniDiff result;
+        const auto change = [&result](const ChangeType type,
+                                const StringView section,
+                                const StringView field,
+                                const StringView oldValue,
+                                const StringView newValue) {
+            result.push_back(IniChange{type,
+                std::string(section.data(), section.size()),
+                std::string(field.data(), field.size()),
+                std::string(oldValue.data(), oldValue.size()),
+                std::string(newValue.data(), newValue.size())});
+        };
+
+        for(const auto &sectionPair : from)
+        {
+            const auto it = to.find(sectionPair.first);
+            if(it == to.end())
+            {
+                change(ChangeType::Removed, sectionPair.first, StringView(), StringView(), StringView());
+                for(const auto &fieldPair : sectionPair.second)
+                    change(ChangeType::Removed, sectionPair.first, fieldPair.first, fieldPair.second.str(), StringView());
+                continue;
+            }
+
+            for(const auto &fieldPair : sectionPair.second)
+            {
+                const auto field = it->second.find(fieldPair.first);
+                if(field == it->second.end())
+                    change(ChangeType::Removed, sectionPair.first, fieldPair.first, fieldPair.second.str(), StringView());
+                else if(field->second.str() != fieldPair.second.str())
+                    change(ChangeType::Changed,
+                        sectionPair.first,
+                        fieldPair.first,
+                        fieldPair.second.str(),
+                        field->second.str());
+            }
+            for(const auto &fieldPair : it->second)
+            {
+                if(sectionPair.second.count(fieldPair.first) == 0)
+                    change(ChangeType::Added, sectionPair.first, fieldPair.first, StringView(), fieldPair.second.str());
+            }
+        }
+
+        for(const auto &sectionPair : to)
+        {
+            if(from.count(sectionPair.first) != 0)
+                continue;
+            change(ChangeType::Added, sectionPair.first, StringView(), StringView(), StringView());
+            for(const auto &fieldPair : sectionPair.second)
+                change(ChangeType::Added, sectionPair.first, fieldPair.first, StringView(), fieldPair.second.str());
+        }
+        return result;
+    }
+
+    /** Detects changes of a single file. On Linux the directory of the file
+      * is watched with inotify, so files which are replaced by a rename are
+      * detected as well. Without inotify every check reports a possible
+      * change, so callers have to pace their checks themselves. */
+    class FileWatcher
+    {
+    private:
+        std::string name_;
+        int fd_ = -1;
+
+    public:
+        explicit FileWatcher(const std::string &fileName)
+        {
+#ifdef INICPP_HAS_INOTIFY
+            const std::size_t slash = fileName.find_last_of('/');
+            const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : fileName.substr(0, slash));
+            name_ = slash == std::string::npos ? fileName : fileName.substr(slash + 1);
+            fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            // only complete writes and renames are reported, so a file is
+            // never read while it is written
+            const std::uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+            if(fd_ >= 0 && ::inotify_add_watch(fd_, dir.c_str(), mask) < 0)
+            {
+                ::close(fd_);
+                fd_ = -1;
+            }
+#else
+            name_ = fileName;
+#endif
+        }
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        ~FileWatcher()
+        {
+#ifdef INICPP_HAS_INOTIFY
+            if(fd_ >= 0)
+                ::close(fd_);
+#endif
+        }
+
+        /** Returns true if changes are reported by the operating system. */
+        bool isNotifying() const
+        {
+            return fd_ >= 0;
+        }
+
+        /** Returns the file descriptor which becomes readable on changes, so
+          * the watcher can be added to an event loop, or -1 without inotify. */
+        int fd() const
+        {
+            return fd_;
+        }
+
+        /** Waits for a change of the file.
+          * @param timeoutMs maximum time to wait in milliseconds, 0 only
+          *        checks for pending changes and -1 waits forever.
+          * @return true if the file may have changed. */
+        bool wait(const int timeoutMs = 0)
+        {
+#ifdef INICPP_HAS_INOTIFY
+            if(fd_ < 0)
+                return true;
+
+            pollfd pfd;
+            pfd.fd = fd_;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            int res;
+            do
+            {
+                res = ::poll(&pfd, 1, timeoutMs);
+            } while(res < 0 && errno == EINTR);
+            if(res <= 0)
+                return false;
+
+            // drain all pending events and look for the watched file
+            bool changed = false;
+            alignas(inotify_event) char buffer[4096];
+            while(true)
+            {
+                const ssize_t len = ::read(fd_, buffer, sizeof(buffer));
+                if(len <= 0)
+                    break;
+                for(ssize_t pos = 0; pos < len;)
+                {
+                    const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + pos);
+                    if((event->mask & (IN_Q_OVERFLOW | IN_IGNORED)) != 0 ||
+                        (event->len > 0 && name_ == event->name))
+                        changed = true;
+                    pos += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+            return changed;
+#else
+            (void) timeoutMs;
+            return true;
+#endif
+        }
+    };
+
+    /** Keeps an ini file up to date with its file on disk. The file is only
+      * decoded again if the hash of its contents changed, the differences to
+      * the current file are passed to the subscribers of the changed sections
+      * and fields. A reloader is not thread-safe. */
+    template<typename File>
+    class IniReloader
+    {
+    public:
+        /** Receives the changes of a reload which match a subscription and
+          * the file after the reload. */
+        using Callback = std::function<void(const IniDiff &, const File &)>;
+
+    private:
+        struct Subscription
+        {
+            std::size_t id;
+            std::string section;
+            std::string field;
+            Callback callback;
+        };
+
+        std::string fileName_;
+        File prototype_;
+        File file_;
+        std::uint64_t hash_ = 0;
+        FileWatcher watcher_;
+        std::vector<Subscription> subscriptions_;
+        std::size_t nextId_ = 1;
+
+        static bool equalNames(const std::string &lhs, const std::string &rhs)
+        {
+            const typename File::comparator_type less{};
+            return !less(lhs, rhs) && !less(rhs, lhs);
+        }
+
+        /** Calls all subscribers whose sections or fields changed. */
+        void notify(const IniDiff &changes) const
+        {
+            for(const Subscription &subscription : subscriptions_)
+            {
+                IniDiff matches;
+                for(const IniChange &change : changes)
+                {
+                    if(!subscription.section.empty() && !equalNames(subscription.section, change.section))
+                        continue;
+                    if(!subscription.field.empty() && !equalNames(subscription.field, change.field))
+                        continue;
+                    matches.push_back(change);
+                }
+                if(!matches.empty())
+                    subscription.callback(matches, file_);
+            }
+        }
+
+    public:
+        /** Loads the given file and starts watching it.
+          * @param fileName path to the watched file.
+          * @param prototype empty file whose format and settings are used to
+          *        decode the file. */
+        explicit IniReloader(const std::string &fileName, const File &prototype = File())
+            : fileName_(fileName), prototype_(prototype), file_(prototype), watcher_(fileName)
+        {
+            FileBuffer buffer;
+            if(buffer.open(fileName_, LoadMode::Stream))
+            {
+                file_.decode(buffer.data(), buffer.size());
+                hash_ = hashBytes(buffer.data(), buffer.size(), false);
+            }
+        }
+
+        /** Returns the current contents of the file. */
+        const File &file() const
+        {
+            return file_;
+        }
+
+        /** Returns the hash of the contents the current file was decoded from. */
+        std::uint64_t contentHash() const
+        {
+            return hash_;
+        }
+
+        FileWatcher &watcher()
+        {
+            return watcher_;
+        }
+
+        /** Registers a callback for all changes. */
+        std::size_t subscribe(const Callback &callback)
+        {
+            return subscribe(std::string(), std::string(), callback);
+        }
+
+        /** Registers a callback for the changes of a section and its fields. */
+        std::size_t subscribe(const std::string &section, const Callback &callback)
+        {
+            return subscribe(section, std::string(), callback);
+        }
+
+        /** Registers a callback for the changes of a single field.
+          * @return id of the subscription. */
+        std::size_t subscribe(const std::string &section, const std::string &field, const Callback &callback)
+        {
+            subscriptions_.push_back(Subscription{nextId_, section, field, callback});
+            return nextId_++;
+        }
+
+        void unsubscribe(const std::size_t id)
+        {
+            subscriptions_.erase(std::remove_if(subscriptions_.begin(),
+                                     subscriptions_.end(),
+                                     [id](const Subscription &subscription) { return subscription.id == id; }),
+                subscriptions_.end());
+        }
+
+        /** Reads the file and applies it if its contents changed. The current
+          * file is kept if the file cannot be read or fails to decode, in
+          * which case the parse error is thrown. Watched files are written
+          * by other processes, so they are always read through a stream
+          * instead of being memory mapped.
+          * @return the applied changes, empty if nothing changed. */
+        IniDiff reload()
+        {
+            FileBuffer buffer;
+            if(!buffer.open(fileName_, LoadMode::Stream))
+                return IniDiff();
+            const std::uint64_t hash = hashBytes(buffer.data(), buffer.size(), false);
+            if(hash == hash_)
+                return IniDiff();
+
+            File next(prototype_);
+            next.decode(buffer.data(), buffer.size());
+            IniDiff changes = diff(file_, next);
+            file_ = std::move(next);
+            hash_ = hash;
+            notify(changes);
+            return changes;
+        }
+
+        /** Waits for a change of the file and reloads it.
+          * @param timeoutMs maximum time to wait in milliseconds, 0 only
+          *        checks for pending changes and -1 waits forever.
+          * @return the applied changes, empty if nothing changed. */
+        IniDiff poll(const int timeoutMs = 0)
+        {
+            if(!watcher_.wait(timeoutMs))
+                return IniDiff();
+            return reload();
+        }
+    };
+
+#ifdef INICPP_HAS_THREADS
+    /************************************************
+     * Snapshots
+     ************************************************/
+
+    /** Immutable version of an ini file which can be shared between threads.
+      * Only const access is possible, which neither inserts nor decodes. */
+    template<typename File>
+    using IniSnapshot = std::shared_ptr<const File>;
+
+    /** Publishes snapshots of an ini file to concurrent readers. Each thread
+      * reads through its own Reader, which keeps the current snapshot alive
+      * and only checks an atomic version counter on access, so reads are
+      * wait-free as long as no new snapshot is published. Publishing swaps
+      * the snapshot atomically, readers see either the old or the new
+      * snapshot as a whole. */
+    template<typename File>
+    class IniPublisher
+    {
+    private:
+        mutable std::mutex mutex_;
+        IniSnapshot<File> current_;
+        std::atomic<std::uint64_t> version_;
+
+    public:
+        /** Thread-local access to the snapshots of a publisher. A reader
+          * must not be shared between threads and must not outlive its
+          * publisher. */
+        class Reader
+        {
+        private:
+            const IniPublisher *publisher_;
+            IniSnapshot<File> snapshot_;
+            std::uint64_t version_;
+
+        public:
+            explicit Reader(const IniPublisher &publisher) : publisher_(&publisher), version_(0)
+            {
+                snapshot_ = publisher_->snapshot(&version_);
+            }
+
+            /** Returns the current snapshot. The reference stays valid until
+              * the next call of get() on this reader. */
+            const File &get()
+            {
+                if(publisher_->version_.load(std::memory_order_acquire) != version_)
+                    snapshot_ = publisher_->snapshot(&version_);
+                return *snapshot_;
+            }
+
+            const File &operator*()
+            {
+                return get();
+            }
+
+            const File *operator->()
+            {
+                return &get();
+            }
+        };
+
+        IniPublisher() : IniPublisher(File())
+        {}
+
+        explicit IniPublisher(File file) : version_(0)
+        {
+            publish(std::move(file));
+        }
+
+        IniPublisher(const IniPublisher &) = delete;
+        IniPublisher &operator=(const IniPublisher &) = delete;
+
+        /** Makes the given file the current snapshot. Sections of lazily
+          * loaded files are decoded first. */
+        void publish(File file)
+        {
+            file.decodeAll();
+            publish(IniSnapshot<File>(std::make_shared<const File>(std::move(file))));
+        }
+
+        /** Makes the given snapshot the current one. All of its sections have
+          * to be decoded already. */
+        void publish(IniSnapshot<File> snapshot)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                current_.swap(snapshot);
+                version_.fetch_add(1, std::memory_order_release);
+            }
+            // the previous snapshot is released outside of the lock
+        }
+
+        /** Returns the current snapshot.
+          * @param version receives the version of the snapshot, if not null. */
+        IniSnapshot<File> snapshot(std::uint64_t *version = nullptr) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(version != nullptr)
+                *version = version_.load(std::memory_order_relaxed);
+            return current_;
+        }
+
+        /** Returns the number of snapshots published so far. */
+        std::uint64_t version() const
+        {
+            return version_.load(std::memory_order_acquire);
+        }
+
+        Reader reader() const
+        {
+            return Reader(*this);
+        }
+    };
+#endif
+
+#ifdef INICPP_HAS_PMR
+    /** Ini files which allocate all of their memory from a
+      * std::pmr::memory_resource. */
+    namespace pmr
+    {
+        using IniField = IniFieldBase<std::pmr::polymorphic_allocator<char>>;
+
+        template<typename Comparator, typename Storage = MapStorage>
+        using IniSectionBase = ini::IniSectionBase<Comparator, Storage, std::pmr::polymorphic_allocator<char>>;
+
+        template<typename Comparator, typename Storage = MapStorage>
+        using IniFileBase = ini::IniFileBase<Comparator, Storage, std::pmr::polymorphic_allocator<char>>;
+
+        using IniFile = IniFileBase<std::less<std::string>>;
+        using IniSection = IniSectionBase<std::less<std::string>>;
+        using IniFileCaseInsensitive = IniFileBase<StringInsensitiveLess>;
+        using IniSectionCaseInsensitive = IniSectionBase<StringInsensitiveLess>;
+    }
+#endif
 }
 
 #endif
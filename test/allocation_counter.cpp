@@ -0,0 +1,81 @@
+/*
+ * allocation_counter.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<std::size_t> allocations(0);
+static std::atomic<std::size_t> bytes(0);
+
+/* The replaced operators forward to a matching pair of functions which are
+ * never inlined, otherwise GCC pairs the inlined malloc of operator new with
+ * the free of operator delete and reports them as mismatched. */
+#if defined(__GNUC__)
+#   define INICPP_TEST_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#   define INICPP_TEST_NOINLINE __declspec(noinline)
+#else
+#   define INICPP_TEST_NOINLINE
+#endif
+
+INICPP_TEST_NOINLINE static void *countedAllocate(const std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if(ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+INICPP_TEST_NOINLINE static void countedDeallocate(void *ptr)
+{
+    std::free(ptr);
+}
+
+std::size_t allocationCount()
+{
+    return allocations.load();
+}
+
+std::size_t allocatedBytes()
+{
+    return bytes.load();
+}
+
+void *operator new(std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    countedDeallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    countedDeallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    countedDeallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    countedDeallocate(ptr);
+}
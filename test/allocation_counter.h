@@ -0,0 +1,47 @@
+/*
+ * allocation_counter.h
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#ifndef INICPP_TEST_ALLOCATION_COUNTER_H_
+#define INICPP_TEST_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+/* The exact allocation counts of the tests hold for libstdc++ and libc++,
+ * which allocate one node per map entry and one buffer per long string.
+ * Other standard libraries allocate sentinel nodes or, in debug builds,
+ * proxies for containers and iterators, so the counts are only checked
+ * where they are known. */
+#if defined(__GLIBCXX__) || defined(_LIBCPP_VERSION)
+#   define REQUIRE_ALLOCATIONS(condition) REQUIRE(condition)
+#else
+#   define REQUIRE_ALLOCATIONS(condition) (void) sizeof(condition)
+#endif
+
+/** Returns the number of calls of the replaced operator new so far. */
+std::size_t allocationCount();
+
+/** Returns the number of bytes requested from operator new so far. */
+std::size_t allocatedBytes();
+
+/** Counts the heap allocations between construction and count(). */
+class AllocationCounter
+{
+private:
+    std::size_t start_;
+
+public:
+    AllocationCounter() : start_(allocationCount())
+    {}
+
+    std::size_t count() const
+    {
+        return allocationCount() - start_;
+    }
+};
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ * test_allocations.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "inicpp.h"
+#include "allocation_counter.h"
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <sstream>
+
+/** Creates an ini document whose names and values do not fit into the small
+  * string buffer, so every string needs exactly one allocation. */
+static std::string makeContent(const std::size_t sections, const std::size_t fields)
+{
+    std::stringstream ss;
+    for(std::size_t i = 0; i < sections; ++i)
+    {
+        ss << "[a section with a long name " << i << "]\n";
+        for(std::size_t j = 0; j < fields; ++j)
+            ss << "a field with a long name " << j << " = a value with an escaped \\# comment prefix " << j << '\n';
+    }
+    return ss.str();
+}
+
+TEST_CASE("decode allocates once per node and string", "Allocations")
+{
+    const std::size_t sections = 10;
+    const std::size_t fields = 20;
+    const std::string content = makeContent(sections, fields);
+    ini::IniFile inif;
+
+    // the parser unescapes the values into a scratch buffer which is reused
+    // for all lines
+    ini::IniHandler ignore;
+    AllocationCounter scratchCounter;
+    inif.parser().parse(content, ignore);
+    const std::size_t scratch = scratchCounter.count();
+    REQUIRE_ALLOCATIONS(scratch <= 2);
+
+    AllocationCounter counter;
+    inif.decode(content.data(), content.size());
+    const std::size_t count = counter.count();
+
+    // one tree node and one name per section, one tree node, one name and
+    // one value per field
+    REQUIRE(inif.size() == sections);
+    REQUIRE_ALLOCATIONS(count == scratch + sections * 2 + sections * fields * 3);
+}
+
+TEST_CASE("decode moves names into hash storage", "Allocations")
+{
+    const std::size_t sections = 10;
+    const std::size_t fields = 20;
+    const std::string content = makeContent(sections, fields);
+    ini::IniFileBase<std::less<std::string>, ini::HashStorage> inif;
+
+    AllocationCounter counter;
+    inif.decode(content.data(), content.size());
+    const std::size_t count = counter.count();
+
+    // the names and values are allocated once, the containers only
+    // allocate when they grow
+    const std::size_t strings = sections + sections * fields * 2;
+    REQUIRE(count >= strings);
+    REQUIRE_ALLOCATIONS(count <= strings + 3 * 6 * (sections + 1));
+}
+
+TEST_CASE("fields are moved without allocating", "Allocations")
+{
+    std::string value = "a value which does not fit into the small string buffer";
+    ini::IniField field(value);
+    ini::IniField other;
+
+    AllocationCounter counter;
+    ini::IniField moved(std::move(field));
+    other = std::move(moved);
+    field = std::move(value);
+    REQUIRE_ALLOCATIONS(counter.count() == 0);
+
+    REQUIRE(other.as<std::string>() == "a value which does not fit into the small string buffer");
+    REQUIRE(field.as<std::string>() == other.as<std::string>());
+}
+
+static_assert(std::is_nothrow_move_assignable<ini::IniField>::value ==
+                  std::is_nothrow_move_assignable<std::string>::value,
+    "fields are nothrow move assignable like their values");
+#ifdef INICPP_HAS_PMR
+static_assert(std::is_nothrow_move_assignable<ini::pmr::IniField>::value ==
+                  std::is_nothrow_move_assignable<std::pmr::string>::value,
+    "fields are nothrow move assignable like their values");
+#endif
+
+TEST_CASE("sections are moved without allocating", "Allocations")
+{
+    ini::IniFile inif;
+    inif["Foo"];
+    ini::IniSection section;
+    section["a field with a long name"] = "a value which does not fit into the small string buffer";
+
+    AllocationCounter counter;
+    inif["Foo"] = std::move(section);
+    REQUIRE_ALLOCATIONS(counter.count() == 0);
+    REQUIRE(inif["Foo"].size() == 1);
+}
+
+TEST_CASE("try_emplace only allocates the node", "Allocations")
+{
+    ini::IniSection section;
+    std::string key = "a field with a long name";
+
+    AllocationCounter counter;
+    auto result = section.try_emplace(std::move(key), ini::IniField());
+    REQUIRE_ALLOCATIONS(counter.count() == 1);
+    REQUIRE(result.second);
+
+    // an existing key is neither replaced nor moved from
+    std::string again = "a field with a long name";
+    result = section.try_emplace(std::move(again), "value");
+    REQUIRE_FALSE(result.second);
+    REQUIRE(again == "a field with a long name");
+    REQUIRE(result.first->second.as<std::string>().empty());
+}
+
+TEMPLATE_TEST_CASE("get does not allocate on hits and misses", "Allocations", ini::MapStorage, ini::FlatStorage, ini::HashStorage)
+{
+#ifndef __cpp_lib_generic_associative_lookup
+    // std::map only supports lookups with string views since C++14, before
+    // that long names are copied into a temporary key
+    if(std::is_same<TestType, ini::MapStorage>::value)
+        return;
+#endif
+    ini::IniFileBase<std::less<std::string>, TestType> inif;
+    inif.decode(makeContent(4, 4));
+    const auto &file = inif;
+    const std::string section = "a section with a long name 2";
+    const std::string field = "a field with a long name 3";
+    const std::string missing = "a field name which does not exist";
+    // convert once, so the value is cached
+    REQUIRE(file.getOr(section, field, std::string()).size() > 0);
+
+    AllocationCounter counter;
+    const bool hit = file.get(section, field) != nullptr;
+    const bool miss = file.get(section, missing) == nullptr && file.get(missing) == nullptr &&
+                      file.get(section, "short") == nullptr;
+    const int fallback = file.getOr(missing, field, 42);
+    REQUIRE_ALLOCATIONS(counter.count() == 0);
+    REQUIRE(hit);
+    REQUIRE(miss);
+    REQUIRE(fallback == 42);
+}
+
+TEST_CASE("short names are looked up in std::map without allocating", "Allocations")
+{
+    ini::IniFile inif;
+    inif.decode("[short]\nkey=a value which does not fit into the small string buffer\n");
+    const ini::IniFile &file = inif;
+    // names which fit into the small string buffer are never copied to the
+    // heap, even on C++11
+    if(std::string().capacity() < std::strlen("missing"))
+        return;
+
+    AllocationCounter counter;
+    const bool hit = file.get("short", "key") != nullptr;
+    const bool miss = file.get("short", "missing") == nullptr && file.get("missing") == nullptr;
+    REQUIRE_ALLOCATIONS(counter.count() == 0);
+    REQUIRE(hit);
+    REQUIRE(miss);
+}
+
+struct AllocationConfig
+{
+    int first = 0;
+    int second = 0;
+    double third = 0.0;
+};
+
+TEST_CASE("binding a struct does not build a map", "Allocations")
+{
+    ini::IniSchema<AllocationConfig> schema;
+    schema.required("A", "first", &AllocationConfig::first)
+        .required("A", "second", &AllocationConfig::second)
+        .optional("B", "third", &AllocationConfig::third, 1.0);
+    const std::string content = makeContent(10, 10) + "[A]\nfirst=1\nsecond=2\n[B]\nthird=3.5\n";
+
+    ini::IniHandler ignore;
+    AllocationCounter scratchCounter;
+    schema.parser().parse(content, ignore);
+    const std::size_t scratch = scratchCounter.count();
+
+    AllocationConfig config;
+    AllocationCounter counter;
+    const ini::IniBindResult result = schema.decode(content, config);
+    const std::size_t count = counter.count();
+    REQUIRE(result.missing.empty());
+    REQUIRE(config.first == 1);
+    REQUIRE(config.second == 2);
+    REQUIRE(config.third == 3.5);
+    REQUIRE(result.unknown.size() == 10);
+    // the flags of the seen fields, the growth of the list of unknown
+    // sections and their names
+    REQUIRE_ALLOCATIONS(count == scratch + 1 + 5 + 10);
+}
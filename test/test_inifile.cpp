@@ -8,8 +8,20 @@
 
 #include "inicpp.h"
 #include <catch2/catch.hpp>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
 #include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef INICPP_HAS_CONSTEXPR_PARSE
+#include "embedded_defaults.h"
+#endif
 
 TEST_CASE("parse ini file", "IniFile")
 {
@@ -21,6 +33,31 @@ TEST_CASE("parse ini file", "IniFile")
     REQUIRE(inif["Test"].size() == 0);
 }
 
+TEST_CASE("parse ini file from character buffer", "IniFile")
+{
+    // the buffer is deliberately not null-terminated after the given size
+    const char data[] = "[Foo]\nbar=hello world\n[Test]\nbaz=nope";
+    ini::IniFile inif;
+    inif.decode(data, sizeof(data) - 10);
+
+    REQUIRE(inif.size() == 2);
+    REQUIRE(inif["Foo"]["bar"].as<std::string>() == "hello world");
+    REQUIRE(inif["Test"].size() == 0);
+}
+
+#ifdef __cpp_lib_string_view
+TEST_CASE("parse ini file from std::string_view", "IniFile")
+{
+    std::string_view content = "[Foo]\r\nbar=hello world\r\n[Test]";
+    ini::IniFile inif;
+    inif.decode(content);
+
+    REQUIRE(inif.size() == 2);
+    REQUIRE(inif["Foo"]["bar"].as<std::string>() == "hello world");
+    REQUIRE(inif["Test"].size() == 0);
+}
+#endif
+
 TEST_CASE("parse empty file", "IniFile")
 {
     std::istringstream ss("");
@@ -251,6 +288,21 @@ TEST_CASE("parse field with custom field sep", "IniFile")
     REQUIRE(inif["Foo"]["bar3"].as<bool>());
 }
 
+TEST_CASE("parse indented field with whitespace field sep", "IniFile")
+{
+    ini::IniFile inif;
+    inif.setFieldSep(' ');
+    inif.decode("[s]\n  key value\n\tother  spaced value \n");
+
+    REQUIRE(inif["s"].size() == 2);
+    REQUIRE(inif["s"]["key"].as<std::string>() == "value");
+    REQUIRE(inif["s"]["other"].as<std::string>() == "spaced value");
+
+    // the separator is only searched within the trimmed line
+    REQUIRE_THROWS_AS(inif.decode("[s]\n  key\n"), std::logic_error);
+    REQUIRE_THROWS_AS(inif.decode("[s]\nkey \n"), std::logic_error);
+}
+
 TEST_CASE("parse with comment", "IniFile")
 {
     std::istringstream ss("[Foo]\n# this is a test\nbar=bla");
@@ -352,6 +404,70 @@ TEST_CASE("escape comment when writing", "IniFile")
                    "world=he\\#llo\n\n");
 }
 
+TEST_CASE("comment matcher prefers prefixes in list order", "IniFile")
+{
+    const std::string str = "//x";
+    const char *end = str.data() + str.size();
+
+    ini::CommentMatcher matcher({"/", "//"});
+    REQUIRE(matcher.match(str.data(), end) != nullptr);
+    REQUIRE(*matcher.match(str.data(), end) == "/");
+
+    matcher = ini::CommentMatcher({"//", "/"});
+    REQUIRE(*matcher.match(str.data(), end) == "//");
+    REQUIRE(*matcher.match(str.data() + 1, end) == "/");
+    REQUIRE(matcher.match(str.data() + 2, end) == nullptr);
+    REQUIRE(matcher.match(end, end) == nullptr);
+}
+
+TEST_CASE("comment matcher does not match beyond the end", "IniFile")
+{
+    const std::string str = "REM";
+    ini::CommentMatcher matcher({"REMARK", "", "#"});
+
+    REQUIRE(matcher.firstBytes() == "#R");
+    REQUIRE(matcher.match(str.data(), str.data() + str.size()) == nullptr);
+}
+
+TEST_CASE("escape comment prefixes sharing a first byte when writing", "IniFile")
+{
+    ini::IniFile inif('=', {"//", "/*", "#"});
+
+    inif["Foo"]["bar"] = "a/b//c/*d#e/";
+
+    const std::string str = inif.encode();
+    REQUIRE(str == "[Foo]\n"
+                   "bar=a/b\\//c\\/*d\\#e/\n\n");
+
+    ini::IniFile inif2('=', {"//", "/*", "#"});
+    inif2.decode(str);
+    REQUIRE(inif2["Foo"]["bar"].as<std::string>() == "a/b//c/*d#e/");
+}
+
+TEST_CASE("escape many comment prefixes in a long value", "IniFile")
+{
+    std::string value;
+    for(size_t i = 0; i < 1000; ++i)
+        value += "ab#;";
+
+    ini::IniFile inif;
+    inif["Foo"]["bar"] = value;
+
+    ini::IniFile inif2;
+    inif2.decode(inif.encode());
+    REQUIRE(inif2["Foo"]["bar"].as<std::string>() == value);
+}
+
+TEST_CASE("comment prefixes can be changed after encoding", "IniFile")
+{
+    ini::IniFile inif;
+    inif["Foo"]["bar"] = "a#b%c";
+    REQUIRE(inif.encode() == "[Foo]\nbar=a\\#b%c\n\n");
+
+    inif.setCommentChar('%');
+    REQUIRE(inif.encode() == "[Foo]\nbar=a#b\\%c\n\n");
+}
+
 TEST_CASE("decode what we encoded", "IniFile")
 {
     std::string content = "[Fo\\#o]\n"
@@ -480,6 +596,45 @@ TEST_CASE("save with unsigned long fields", "IniFile")
     REQUIRE(result == "[Foo]\nbar1=1\nbar2=13\n\n");
 }
 
+TEMPLATE_TEST_CASE("encode integers like std::to_string", "IniFile", short, unsigned short, int, unsigned int, long, unsigned long)
+{
+    std::vector<TestType> values = {0, 1, 9, 10, 99, 100, 101, 999, 1000,
+        std::numeric_limits<TestType>::min(), std::numeric_limits<TestType>::max(),
+        static_cast<TestType>(std::numeric_limits<TestType>::min() + 1),
+        static_cast<TestType>(std::numeric_limits<TestType>::max() - 1)};
+    for(TestType value = 1; value < std::numeric_limits<TestType>::max() / 7; value = static_cast<TestType>(value * 7 + 3))
+    {
+        values.push_back(value);
+        if(std::numeric_limits<TestType>::is_signed)
+            values.push_back(static_cast<TestType>(-value));
+    }
+
+    ini::Convert<TestType> conv;
+    for(const TestType value : values)
+    {
+        std::string result;
+        conv.encode(value, result);
+        REQUIRE(result == std::to_string(value));
+
+        TestType decoded;
+        conv.decode(result, decoded);
+        REQUIRE(decoded == value);
+    }
+}
+
+TEST_CASE("encode integers into the existing buffer", "IniFile")
+{
+    std::string result;
+    result.reserve(64);
+    const char *data = result.data();
+
+    ini::encodeInteger(-1234567890L, result);
+    REQUIRE(result == "-1234567890");
+    ini::encodeInteger(42U, result);
+    REQUIRE(result == "42");
+    REQUIRE(result.data() == data);
+}
+
 TEST_CASE("save with double fields", "IniFile")
 {
     ini::IniFile inif;
@@ -500,6 +655,118 @@ TEST_CASE("save with float fields", "IniFile")
     REQUIRE(result == "[Foo]\nbar1=1.2\nbar2=-2.4\n\n");
 }
 
+TEMPLATE_TEST_CASE("floating point numbers round-trip exactly", "IniFile", float, double)
+{
+    using Limits = std::numeric_limits<TestType>;
+    std::vector<TestType> values = {0, -0.0, 1, -1, 0.1, 0.2, 1.2, -2.4, 1e-5, 1e5, 1e20, 123456789.125,
+        Limits::min(), Limits::max(), Limits::lowest(), Limits::epsilon(), Limits::denorm_min(),
+        Limits::infinity(), -Limits::infinity(), static_cast<TestType>(0.1) + static_cast<TestType>(0.2)};
+
+    // random bit patterns cover all exponents and mantissas
+    std::mt19937_64 rng(42);
+    while(values.size() < 10000)
+    {
+        const std::uint64_t bits = rng();
+        TestType value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if(!std::isnan(value))
+            values.push_back(value);
+    }
+
+    ini::Convert<TestType> conv;
+    for(const TestType value : values)
+    {
+        std::string str;
+        conv.encode(value, str);
+        TestType decoded;
+        conv.decode(str, decoded);
+        INFO(str);
+        REQUIRE(std::memcmp(&decoded, &value, sizeof(value)) == 0);
+    }
+
+    std::string str;
+    conv.encode(Limits::quiet_NaN(), str);
+    TestType decoded;
+    conv.decode(str, decoded);
+    REQUIRE(std::isnan(decoded));
+}
+
+TEST_CASE("floating point numbers are encoded with the shortest representation", "IniFile")
+{
+    ini::IniField field;
+
+    field = 0.1;
+    REQUIRE(field.as<std::string>() == "0.1");
+    field = 0.1 + 0.2;
+    REQUIRE(field.as<std::string>() == "0.30000000000000004");
+    field = 100.0;
+    REQUIRE(field.as<std::string>() == "100");
+    field = 1e20;
+    REQUIRE(field.as<std::string>() == "1e+20");
+    field = -1.5e-7;
+    REQUIRE(field.as<std::string>() == "-1.5e-07");
+    field = 1.0f / 3.0f;
+    REQUIRE(field.as<std::string>() == "0.33333334");
+    field = 16777216.0f;
+    REQUIRE(field.as<std::string>() == "16777216");
+}
+
+TEST_CASE("parse floating point numbers", "IniFile")
+{
+    const char *values[] = {"1", "+1.5", "-.5", "2.", "1e3", "1E+3", "-1e-3", "inf", "-Infinity", "NaN"};
+    const double expected[] = {1, 1.5, -0.5, 2, 1000, 1000, -0.001, std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(), 0};
+    for(std::size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i)
+    {
+        ini::IniField field(values[i]);
+        INFO(values[i]);
+        if(i == 9)
+            REQUIRE(std::isnan(field.as<double>()));
+        else
+            REQUIRE(field.as<double>() == expected[i]);
+    }
+}
+
+TEST_CASE("fail to parse malformed floating point numbers", "IniFile")
+{
+    const char *values[] = {"", ".", "-", "+-1", "1.5abc", "abc", "1e", "1e+", "1,5", "1 ", " 1", "0x1p3", "in", "nanx", "1.2.3"};
+    for(const char *value : values)
+    {
+        ini::IniField field(value);
+        INFO(value);
+        REQUIRE_THROWS_AS(field.as<double>(), std::invalid_argument);
+        REQUIRE_THROWS_AS(field.as<float>(), std::invalid_argument);
+    }
+}
+
+TEST_CASE("fail to parse floating point numbers out of range", "IniFile")
+{
+    REQUIRE_THROWS_AS(ini::IniField("1e400").as<double>(), std::out_of_range);
+    REQUIRE_THROWS_AS(ini::IniField("-1e400").as<double>(), std::out_of_range);
+    REQUIRE_THROWS_AS(ini::IniField("1e-400").as<double>(), std::out_of_range);
+    REQUIRE_THROWS_AS(ini::IniField("1e40").as<float>(), std::out_of_range);
+    REQUIRE(ini::IniField("1e40").as<double>() == 1e40);
+}
+
+TEST_CASE("floating point syntax is checked independent of the locale", "IniFile")
+{
+    const std::string valid[] = {"1.5", "-.5e-3", "+2.", "INF", "nan"};
+    for(const std::string &value : valid)
+        REQUIRE(ini::isFloatingPointSyntax(value.data(), value.data() + value.size()));
+
+    const std::string invalid[] = {"1,5", "1.5.", "e5", "0x10", "infinit"};
+    for(const std::string &value : invalid)
+        REQUIRE_FALSE(ini::isFloatingPointSyntax(value.data(), value.data() + value.size()));
+
+    char buf[] = "-1,25e+02";
+    char *end = ini::delocalizeDecimalPoint(buf, buf + 9, ",");
+    REQUIRE(std::string(buf, end) == "-1.25e+02");
+
+    char buf2[] = "1<dp>5";
+    end = ini::delocalizeDecimalPoint(buf2, buf2 + 6, "<dp>");
+    REQUIRE(std::string(buf2, end) == "1.5");
+}
+
 TEST_CASE("save with std::string fields", "IniFile")
 {
     ini::IniFile inif;
@@ -623,6 +890,25 @@ TEST_CASE("multi-line values are read correctly with tab indents", "IniFile")
     REQUIRE(inif["Foo"]["bar"].as<std::string>() == "Hello\nworld!");
 }
 
+TEST_CASE("parse long multi-line values", "IniFile")
+{
+    std::string content = "[Foo]\nbar=line0\n";
+    std::string expected = "line0";
+    for(int i = 1; i < 2000; ++i)
+    {
+        content += "\tline" + std::to_string(i) + " \\# # comment\n";
+        expected += "\nline" + std::to_string(i) + " #";
+    }
+    content += "baz=1\n";
+
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    inif.decode(content);
+
+    REQUIRE(inif["Foo"]["bar"].as<std::string>() == expected);
+    REQUIRE(inif["Foo"]["baz"].as<int>() == 1);
+}
+
 TEST_CASE("multi-line values discard end-of-line comments", "IniFile")
 {
     std::istringstream ss("[Foo]\n"
@@ -716,6 +1002,61 @@ TEST_CASE("stringInsensitiveLess operator() has a case insensitive strict weak o
     REQUIRE(cc("B", "a") == false);
 }
 
+TEST_CASE("stringInsensitiveLess operator() matches comparing lower case copies", "StringInsensitiveLessFunctor")
+{
+    ini::StringInsensitiveLess cc;
+    ini::StringInsensitiveEqual eq;
+    ini::StringInsensitiveHash hash;
+    const char alphabet[] = "aAzZ@[`{09_\x80\xc4\xe4";
+
+    // compare pseudo random strings of various lengths, so both the block
+    // wise and the character wise comparison are exercised
+    unsigned int state = 7;
+    for(int i = 0; i < 2000; ++i)
+    {
+        std::string lhs;
+        std::string rhs;
+        state = state * 1103515245u + 12345u;
+        const std::size_t size = (state >> 8) % 24;
+        for(std::size_t j = 0; j < size; ++j)
+        {
+            state = state * 1103515245u + 12345u;
+            lhs += alphabet[(state >> 8) % (sizeof(alphabet) - 1)];
+            // mostly use the same character with random case for rhs
+            const char c = lhs.back();
+            rhs += (state >> 20) % 8 == 0 ? alphabet[(state >> 12) % (sizeof(alphabet) - 1)]
+                                          : static_cast<char>((state >> 16) % 2 ? ::toupper(c) : ::tolower(c));
+        }
+        if((state >> 24) % 4 == 0)
+            rhs += 'x';
+
+        std::string lhsLower = lhs;
+        std::string rhsLower = rhs;
+        for(char &c : lhsLower)
+            c = static_cast<char>(ini::toLowerAscii(static_cast<unsigned char>(c)));
+        for(char &c : rhsLower)
+            c = static_cast<char>(ini::toLowerAscii(static_cast<unsigned char>(c)));
+
+        REQUIRE(cc(lhs, rhs) == (lhsLower < rhsLower));
+        REQUIRE(cc(rhs, lhs) == (rhsLower < lhsLower));
+        REQUIRE(eq(lhs, rhs) == (lhsLower == rhsLower));
+        if(lhsLower == rhsLower)
+            REQUIRE(hash(lhs) == hash(rhs));
+    }
+}
+
+TEST_CASE("toLowerAscii() converts blocks of characters", "StringInsensitiveLessFunctor")
+{
+    const char input[] = "@AZ[`az{";
+    std::uint64_t block;
+    std::memcpy(&block, input, 8);
+    block = ini::toLowerAscii(block);
+
+    char output[9] = {0};
+    std::memcpy(output, &block, 8);
+    REQUIRE(std::string(output) == "@az[`az{");
+}
+
 TEST_CASE("default inifile parser is case sensitive", "IniFile")
 {
     std::istringstream ss("[FOO]\nbar=bla");
@@ -750,6 +1091,336 @@ TEST_CASE(".as<>() works with IniFileCaseInsensitive", "IniFile")
     REQUIRE(inif["FOO"]["bar"].as<std::string>() == "bla");
 }
 
+TEMPLATE_TEST_CASE("parse ini file with storage policy", "IniFile", ini::MapStorage, ini::FlatStorage, ini::HashStorage)
+{
+    using IniFileT = ini::IniFileBase<std::less<std::string>, TestType>;
+    IniFileT inif;
+    inif.decode("[Foo]\nbar=hello\nbaz=world\n[Test]\n[Foo]\nbar=again");
+
+    REQUIRE(inif.size() == 2);
+    REQUIRE(inif.count("Foo") == 1);
+    REQUIRE(inif.find("Bar") == inif.end());
+    REQUIRE(inif["Foo"].size() == 2);
+    REQUIRE(inif["Foo"]["bar"].template as<std::string>() == "again");
+    REQUIRE(inif["Foo"]["baz"].template as<std::string>() == "world");
+    REQUIRE(inif.at("Test").size() == 0);
+    REQUIRE_THROWS_AS(inif.at("Bar"), std::out_of_range);
+}
+
+TEMPLATE_TEST_CASE("case insensitive ini file with storage policy",
+    "IniFile",
+    ini::MapStorage,
+    ini::FlatStorage,
+    ini::HashStorage)
+{
+    using IniFileT = ini::IniFileBase<ini::StringInsensitiveLess, TestType>;
+    IniFileT inif;
+    inif.decode("[FOO]\nbar=bla");
+
+    REQUIRE(inif.find("foo") != inif.end());
+    REQUIRE(inif["Foo"].find("BAR") != inif["Foo"].end());
+    REQUIRE(inif["fOO"]["Bar"].template as<std::string>() == "bla");
+}
+
+TEMPLATE_TEST_CASE("encode ini file with storage policy", "IniFile", ini::MapStorage, ini::FlatStorage)
+{
+    using IniFileT = ini::IniFileBase<std::less<std::string>, TestType>;
+    IniFileT inif;
+    inif["Foo"]["b"] = 2;
+    inif["Foo"]["a"] = 1;
+    inif["Bar"]["c"] = 3;
+
+    REQUIRE(inif.encode() == "[Bar]\nc=3\n\n[Foo]\na=1\nb=2\n\n");
+}
+
+TEMPLATE_TEST_CASE("look up sections and fields without building keys",
+    "IniFile",
+    ini::MapStorage,
+    ini::FlatStorage,
+    ini::HashStorage)
+{
+    using IniFileT = ini::IniFileBase<std::less<std::string>, TestType>;
+    IniFileT inif;
+    inif.decode("[Foo]\nbar=hello\n");
+    const IniFileT &cinif = inif;
+    const char *section = "Foo";
+
+    REQUIRE(inif.find(section) != inif.end());
+    REQUIRE(cinif.find("Foo") != cinif.end());
+    REQUIRE(cinif.find("foo") == cinif.end());
+    REQUIRE(inif.contains("Foo"));
+    REQUIRE_FALSE(cinif.contains("Bar"));
+    REQUIRE(cinif.count("Foo") == 1);
+    REQUIRE(cinif.at("Foo").at("bar").template as<std::string>() == "hello");
+    REQUIRE_THROWS_AS(cinif.at("Foo").at("baz"), std::out_of_range);
+    REQUIRE(inif["Foo"]["bar"].template as<std::string>() == "hello");
+    REQUIRE(inif.at(ini::StringView("Foo")).contains(ini::StringView("bar")));
+
+    // heterogeneous operator[] still inserts missing elements
+    inif["Bar"]["baz"] = 1;
+    REQUIRE(inif.size() == 2);
+    REQUIRE(inif.contains("Bar"));
+    REQUIRE(inif["Bar"].contains("baz"));
+
+#ifdef __cpp_lib_string_view
+    std::string_view name = "Foo";
+    REQUIRE(inif.find(name) != inif.end());
+    REQUIRE(inif.contains(name));
+    REQUIRE(inif[name]["bar"].template as<std::string>() == "hello");
+#endif
+}
+
+TEMPLATE_TEST_CASE("look up case insensitive sections and fields without building keys",
+    "IniFile",
+    ini::MapStorage,
+    ini::FlatStorage,
+    ini::HashStorage)
+{
+    using IniFileT = ini::IniFileBase<ini::StringInsensitiveLess, TestType>;
+    IniFileT inif;
+    inif.decode("[Foo]\nbar=hello\n");
+
+    REQUIRE(inif.find("FOO") != inif.end());
+    REQUIRE(inif.contains("foo"));
+    REQUIRE(inif.at("fOO").contains("BAR"));
+    REQUIRE(inif["FOO"]["Bar"].template as<std::string>() == "hello");
+    REQUIRE(inif.size() == 1);
+}
+
+TEMPLATE_TEST_CASE("sections support try_emplace and rvalue fields", "IniFile", ini::MapStorage, ini::FlatStorage, ini::HashStorage)
+{
+    using SectionT = ini::IniSectionBase<std::less<std::string>, TestType>;
+    SectionT section;
+
+    std::string key = "foo";
+    auto result = section.try_emplace(std::move(key), "bar");
+    REQUIRE(result.second);
+    REQUIRE(result.first->second.template as<std::string>() == "bar");
+
+    std::string again = "foo";
+    result = section.try_emplace(std::move(again), "baz");
+    REQUIRE_FALSE(result.second);
+    REQUIRE(again == "foo");
+    REQUIRE(section["foo"].template as<std::string>() == "bar");
+
+    std::string value = "moved";
+    section["foo"] = std::move(value);
+    REQUIRE(section["foo"].template as<std::string>() == "moved");
+
+    ini::IniField field("other");
+    section["bar"] = std::move(field);
+    REQUIRE(section["bar"].template as<std::string>() == "other");
+    REQUIRE(section.size() == 2);
+}
+
+TEST_CASE("hash storage iterates in insertion order", "IniFile")
+{
+    ini::IniFileBase<std::less<std::string>, ini::HashStorage> inif;
+    inif["Foo"]["b"] = 2;
+    inif["Foo"]["a"] = 1;
+    inif["Bar"]["c"] = 3;
+
+    REQUIRE(inif.encode() == "[Foo]\nb=2\na=1\n\n[Bar]\nc=3\n\n");
+}
+
+#ifdef INICPP_HAS_PMR
+/** Memory resource which counts the allocations passed to its upstream. */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations = 0;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/** Makes all allocations from the default memory resource fail while it is
+  * alive, so nothing can silently bypass the resource of an ini file. */
+struct NoDefaultResource
+{
+    std::pmr::memory_resource *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    ~NoDefaultResource()
+    {
+        std::pmr::set_default_resource(previous);
+    }
+};
+
+TEMPLATE_TEST_CASE("decode into a memory resource with storage policy",
+    "IniFile",
+    ini::MapStorage,
+    ini::FlatStorage,
+    ini::HashStorage)
+{
+    using IniFileT = ini::pmr::IniFileBase<std::less<std::string>, TestType>;
+    CountingResource counter;
+    std::pmr::monotonic_buffer_resource arena(&counter);
+    {
+        IniFileT inif(&arena);
+        {
+            NoDefaultResource guard;
+            inif.decode("[Foo]\n"
+                        "bar=a value which is too long for the small string buffer\n"
+                        "baz=42\n"
+                        "[A section name which does not fit into the small string buffer]\n"
+                        "a field name which does not fit into the small string buffer=1.5\n");
+            inif["Foo"]["new"] = "another value which is too long for the small string buffer";
+            inif["Bar"]["x"] = 1;
+        }
+
+        REQUIRE(counter.allocations > 0);
+        REQUIRE(inif.size() == 3);
+        REQUIRE(inif["Foo"]["bar"].template as<std::string>() == "a value which is too long for the small string buffer");
+        REQUIRE(inif["Foo"]["baz"].template as<int>() == 42);
+        REQUIRE(inif.at("A section name which does not fit into the small string buffer")
+                    .at("a field name which does not fit into the small string buffer")
+                    .template as<double>() == 1.5);
+        REQUIRE(inif["Foo"].get_allocator().resource() == &arena);
+        REQUIRE(inif["Foo"]["bar"].get_allocator().resource() == &arena);
+    }
+}
+
+TEST_CASE("encode ini file from a memory resource", "IniFile")
+{
+    std::pmr::monotonic_buffer_resource arena;
+    ini::pmr::IniFile inif(&arena);
+    const std::string content = "[Foo]\nbar=he\\#llo\nbaz=1\n\n";
+    inif.decode(content);
+
+    REQUIRE(inif.encode() == content);
+    REQUIRE(inif["Foo"]["bar"].as<const char *>() == std::string("he#llo"));
+
+    ini::pmr::IniSection section(&arena);
+    section["a"] = "b";
+    inif["Bar"] = section;
+    REQUIRE(inif["Bar"]["a"].as<std::string>() == "b");
+    REQUIRE(inif["Bar"].get_allocator().resource() == &arena);
+}
+#endif
+
+TEMPLATE_TEST_CASE("storage containers behave like std::map",
+    "StorageContainer",
+    (ini::FlatMap<std::string, int, std::less<std::string>>),
+    (ini::HashMap<std::string, int, std::hash<std::string>, std::equal_to<std::string>>))
+{
+    TestType container;
+    std::map<std::string, int> expected;
+
+    // insert and erase pseudo random keys, so the hash map has to deal with
+    // collisions, rehashing and backward shift deletion
+    unsigned int state = 42;
+    for(int i = 0; i < 5000; ++i)
+    {
+        state = state * 1103515245u + 12345u;
+        const std::string key = "key" + std::to_string((state >> 8) % 300);
+        if(((state >> 4) & 3) == 0)
+        {
+            REQUIRE(container.erase(key) == expected.erase(key));
+        }
+        else
+        {
+            container[key] = i;
+            expected[key] = i;
+        }
+
+        REQUIRE(container.size() == expected.size());
+    }
+
+    for(const auto &pair : expected)
+    {
+        REQUIRE(container.count(pair.first) == 1);
+        REQUIRE(container.at(pair.first) == pair.second);
+    }
+    REQUIRE(container.find("missing") == container.end());
+
+    std::size_t cnt = 0;
+    for(auto it = container.begin(); it != container.end(); ++it)
+        ++cnt;
+    REQUIRE(cnt == expected.size());
+}
+
+TEST_CASE("byte scanner kernels find the same bytes", "ByteScanner")
+{
+    const ini::ScanKernel kernels[] = {ini::ScanKernel::Scalar, ini::ScanKernel::SSE2, ini::ScanKernel::AVX2};
+    const char alphabet[] = "abc =#;[]\\\n\t\x80\xff";
+
+    unsigned int state = 3;
+    std::string buffer;
+    for(int i = 0; i < 4096; ++i)
+    {
+        state = state * 1103515245u + 12345u;
+        // mostly use letters, so there are long runs without a match
+        buffer += (state >> 16) % 8 == 0 ? alphabet[(state >> 8) % (sizeof(alphabet) - 1)] : 'x';
+    }
+
+    const char *sets[] = {"\n", "=#;[]\\\n", "\x80\xff", "abcdefghij=#"};
+    for(const char *set : sets)
+    {
+        ini::ByteScanner expected(set);
+        expected.setKernel(ini::ScanKernel::Scalar);
+
+        for(const ini::ScanKernel kernel : kernels)
+        {
+            ini::ByteScanner scanner(set);
+            scanner.setKernel(kernel);
+
+            const char *end = buffer.data() + buffer.size();
+            for(std::size_t offset = 0; offset < 64; ++offset)
+            {
+                const char *pos = buffer.data() + offset;
+                const char *expectedPos = pos;
+                while(pos != end)
+                {
+                    pos = scanner.find(pos, end);
+                    expectedPos = expected.find(expectedPos, end);
+                    REQUIRE(pos == expectedPos);
+                    if(pos != end)
+                    {
+                        REQUIRE(scanner.contains(*pos));
+                        ++pos;
+                        ++expectedPos;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("decode with all scan kernels", "IniFile")
+{
+    const ini::ScanKernel kernels[] = {ini::ScanKernel::Scalar, ini::ScanKernel::SSE2, ini::ScanKernel::AVX2};
+    const std::string content = "[Some Section With A Long Name] # a comment that is longer than one block\n"
+                                "a_long_field_name_to_fill_a_block = a long value \\# with an escaped comment ; x\n"
+                                "short=1\n";
+
+    for(const ini::ScanKernel kernel : kernels)
+    {
+        ini::IniFile inif;
+        inif.setScanKernel(kernel);
+        inif.decode(content);
+
+        REQUIRE(inif.size() == 1);
+        REQUIRE(inif["Some Section With A Long Name"].size() == 2);
+        REQUIRE(inif["Some Section With A Long Name"]["a_long_field_name_to_fill_a_block"].as<std::string>() ==
+                "a long value # with an escaped comment");
+        REQUIRE(inif["Some Section With A Long Name"]["short"].as<int>() == 1);
+    }
+}
+
 TEST_CASE("trim() works with empty strings", "TrimFunction")
 {
     std::string example1 = "";
@@ -792,6 +1463,286 @@ TEST_CASE("trim() works with untrimmed strings", "TrimFunction")
     REQUIRE(example4 == "example  \t\n  text");
 }
 
+TEST_CASE("load ini file with all load modes", "IniFile")
+{
+    const std::string fileName = "test_load_modes.ini";
+    {
+        std::ofstream os(fileName.c_str());
+        os << "[Foo]\nbar=hello world\n[Test]\nbaz=42\n";
+    }
+
+    const ini::LoadMode modes[] = {ini::LoadMode::Stream, ini::LoadMode::Mapped, ini::LoadMode::MappedPopulate};
+    for(const ini::LoadMode mode : modes)
+    {
+        ini::IniFile inif;
+        inif.setLoadMode(mode);
+        inif.load(fileName);
+
+        REQUIRE(inif.size() == 2);
+        REQUIRE(inif["Foo"]["bar"].as<std::string>() == "hello world");
+        REQUIRE(inif["Test"]["baz"].as<int>() == 42);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+/** Writes the given content to a file. */
+static void writeFile(const std::string &fileName, const std::string &content)
+{
+    std::ofstream os(fileName.c_str(), std::ios::binary);
+    os << content;
+}
+
+static const char *lazyContent()
+{
+    return "# prologue\n"
+           "[Foo]\n"
+           "bar=hello world\n"
+           "[Multi]\n"
+           "text=first\n"
+           "  second\n"
+           "[Esc\\#aped] ; comment\n"
+           "a\\;b=c\\#d\n"
+           "[Foo]\n"
+           "baz=42\n"
+           "bar=overwritten\n";
+}
+
+TEMPLATE_TEST_CASE("lazy load decodes sections on first access", "IniFile", ini::MapStorage, ini::FlatStorage, ini::HashStorage)
+{
+    const std::string fileName = "test_lazy_load.ini";
+    writeFile(fileName, lazyContent());
+
+    const ini::LoadMode modes[] = {ini::LoadMode::Stream, ini::LoadMode::Mapped};
+    for(const ini::LoadMode mode : modes)
+    {
+        ini::IniFileBase<std::less<std::string>, TestType> inif;
+        inif.setMultiLineValues(true);
+        inif.setLoadMode(mode);
+        inif.setLazyLoad(true);
+        inif.load(fileName);
+
+        REQUIRE(inif.size() == 3);
+        REQUIRE(inif.lazySectionCount() == 3);
+        REQUIRE(inif.count("Foo") == 1);
+        REQUIRE(inif.lazySectionCount() == 3);
+
+        REQUIRE(inif["Foo"]["bar"].template as<std::string>() == "overwritten");
+        REQUIRE(inif["Foo"]["baz"].template as<int>() == 42);
+        REQUIRE(inif.lazySectionCount() == 2);
+
+        REQUIRE(inif.find("Esc#aped") != inif.end());
+        REQUIRE(inif.find("Esc#aped")->second["a;b"].template as<std::string>() == "c#d");
+        REQUIRE(inif.lazySectionCount() == 1);
+
+        REQUIRE(inif.at("Multi")["text"].template as<std::string>() == "first\nsecond");
+        REQUIRE(inif.lazySectionCount() == 0);
+
+        ini::IniFileBase<std::less<std::string>, TestType> eager;
+        eager.setMultiLineValues(true);
+        eager.load(fileName);
+        REQUIRE(inif.encode() == eager.encode());
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("lazy load decodes all sections when iterating", "IniFile")
+{
+    const std::string fileName = "test_lazy_iterate.ini";
+    writeFile(fileName, lazyContent());
+
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    inif.setLazyLoad(true);
+    inif.load(fileName);
+
+    std::size_t fields = 0;
+    for(const auto &section : inif)
+        fields += section.second.size();
+    REQUIRE(fields == 4);
+    REQUIRE(inif.lazySectionCount() == 0);
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("lazy load reports errors of a section on first access", "IniFile")
+{
+    const std::string fileName = "test_lazy_errors.ini";
+    writeFile(fileName, "[Foo]\nbar=1\n[Broken]\nbar=1\nno separator\n");
+
+    ini::IniFile inif;
+    inif.setLazyLoad(true);
+    inif.load(fileName);
+    REQUIRE(inif["Foo"]["bar"].as<int>() == 1);
+    REQUIRE_THROWS_WITH(inif["Broken"], "l.5: ini parsing failed, no '=' found");
+    // the section is not left half decoded
+    REQUIRE(inif.lazySectionCount() == 1);
+    REQUIRE_THROWS_WITH(inif.at("Broken"), "l.5: ini parsing failed, no '=' found");
+    REQUIRE_THROWS_WITH(inif.decodeAll(), "l.5: ini parsing failed, no '=' found");
+
+    writeFile(fileName, "[Foo]\nbar=1\n[Foo\n");
+    REQUIRE_THROWS_WITH(inif.load(fileName), "l.3: ini parsing failed, section not closed");
+
+    writeFile(fileName, "# comment\nbar=1\n[Foo]\n");
+    REQUIRE_THROWS_WITH(inif.load(fileName),
+        "l.2: ini parsing failed, field has no section or ini file in use by another application");
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("lazy load detects duplicate fields in repeated sections", "IniFile")
+{
+    const std::string fileName = "test_lazy_duplicates.ini";
+    writeFile(fileName, "[Foo]\nbar=1\n[Baz]\n[Foo]\nbar=2\n");
+
+    ini::IniFile inif;
+    inif.setLazyLoad(true);
+    inif.allowOverwriteDuplicateFields(false);
+    inif.load(fileName);
+    REQUIRE_THROWS_WITH(inif.find("Foo"), "l.5: ini parsing failed, duplicate field found");
+    REQUIRE_THROWS_WITH(inif.find("Foo"), "l.5: ini parsing failed, duplicate field found");
+
+    std::remove(fileName.c_str());
+}
+
+#ifdef INICPP_HAS_THREADS
+TEST_CASE("lazy load decodes sections for concurrent const readers", "IniFile")
+{
+    const std::string fileName = "test_lazy_concurrent.ini";
+    std::string content;
+    for(int i = 0; i < 50; ++i)
+    {
+        content += "[section" + std::to_string(i) + "]\n";
+        for(int j = 0; j < 20; ++j)
+            content += "field" + std::to_string(j) + "=" + std::to_string(i * j) + "\n";
+    }
+    writeFile(fileName, content);
+
+    ini::IniFile inif;
+    inif.setLazyLoad(true);
+    inif.load(fileName);
+    const ini::IniFile &file = inif;
+
+    std::atomic<int> errors(0);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&file, &errors]() {
+            for(int i = 0; i < 50; ++i)
+            {
+                const auto it = file.find("section" + std::to_string(i));
+                if(it == file.end() || it->second.at("field7").as<int>() != i * 7)
+                    ++errors;
+            }
+        });
+    }
+    for(std::thread &thread : threads)
+        thread.join();
+
+    REQUIRE(errors == 0);
+    REQUIRE(file.lazySectionCount() == 0);
+    std::remove(fileName.c_str());
+}
+#endif
+
+TEST_CASE("copies of a lazily loaded file share its contents", "IniFile")
+{
+    const std::string fileName = "test_lazy_copy.ini";
+    writeFile(fileName, "[Foo]\nbar=1\n[Baz]\nqux=2\n");
+
+    ini::IniFile copy;
+    {
+        ini::IniFile inif;
+        inif.setLazyLoad(true);
+        inif.load(fileName);
+        REQUIRE(inif["Foo"]["bar"].as<int>() == 1);
+        copy = inif;
+    }
+    std::remove(fileName.c_str());
+
+    REQUIRE(copy.lazySectionCount() == 1);
+    REQUIRE(copy["Baz"]["qux"].as<int>() == 2);
+    REQUIRE(copy["Foo"]["bar"].as<int>() == 1);
+
+    copy.decode("[Other]\nkey=value");
+    REQUIRE(copy.lazySectionCount() == 0);
+    REQUIRE(copy.size() == 1);
+}
+
+TEST_CASE("lazy load of case insensitive file merges sections", "IniFile")
+{
+    const std::string fileName = "test_lazy_case.ini";
+    writeFile(fileName, "[Foo]\nbar=1\n[FOO]\nbaz=2\n");
+
+    ini::IniFileCaseInsensitive inif;
+    inif.setLazyLoad(true);
+    inif.load(fileName);
+    REQUIRE(inif.size() == 1);
+    REQUIRE(inif["foo"].size() == 2);
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("load empty ini file", "IniFile")
+{
+    const std::string fileName = "test_load_empty.ini";
+    {
+        std::ofstream os(fileName.c_str());
+    }
+
+    ini::IniFile inif;
+    inif.load(fileName);
+    REQUIRE(inif.size() == 0);
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("file buffer maps regular files", "FileBuffer")
+{
+    const std::string fileName = "test_file_buffer.ini";
+    {
+        std::ofstream os(fileName.c_str());
+        os << "[Foo]";
+    }
+
+    ini::FileBuffer buffer;
+    REQUIRE(buffer.open(fileName, ini::LoadMode::Mapped));
+    REQUIRE(std::string(buffer.data(), buffer.size()) == "[Foo]");
+#ifdef INICPP_HAS_MMAP
+    REQUIRE(buffer.mapped());
+#endif
+
+    REQUIRE(buffer.open(fileName, ini::LoadMode::Stream));
+    REQUIRE(std::string(buffer.data(), buffer.size()) == "[Foo]");
+    REQUIRE_FALSE(buffer.mapped());
+
+    // files are only mapped on request
+    REQUIRE(buffer.open(fileName));
+    REQUIRE(std::string(buffer.data(), buffer.size()) == "[Foo]");
+    REQUIRE_FALSE(buffer.mapped());
+
+    buffer.close();
+    std::remove(fileName.c_str());
+}
+
+#ifdef INICPP_HAS_MMAP
+TEST_CASE("file buffer reads special files", "FileBuffer")
+{
+    ini::FileBuffer buffer;
+    REQUIRE(buffer.open("/dev/null", ini::LoadMode::Mapped));
+    REQUIRE(buffer.size() == 0);
+    REQUIRE_FALSE(buffer.mapped());
+}
+#endif
+
+TEST_CASE("file buffer fails on missing files", "FileBuffer")
+{
+    ini::FileBuffer buffer;
+    REQUIRE_FALSE(buffer.open("this_file_does_not_exist.ini", ini::LoadMode::Mapped));
+    REQUIRE_FALSE(buffer.open("this_file_does_not_exist.ini", ini::LoadMode::Stream));
+}
+
 /***************************************************
  *                Failing Tests
  ***************************************************/
@@ -856,6 +1807,160 @@ TEST_CASE("fail to parse as int", "IniFile")
     REQUIRE_THROWS(inif["Foo"]["bar"].as<int>());
 }
 
+TEST_CASE("decoded values are updated when the field is assigned", "IniFile")
+{
+    ini::IniField field("42");
+
+    REQUIRE(field.as<int>() == 42);
+    REQUIRE(field.as<int>() == 42);
+    REQUIRE(field.as<double>() == 42.0);
+    REQUIRE(field.as<int>() == 42);
+
+    field = 7;
+    REQUIRE(field.as<int>() == 7);
+    field = std::string("1.5");
+    REQUIRE(field.as<double>() == 1.5);
+    REQUIRE_THROWS(field.as<int>());
+
+    field = ini::IniField("true");
+    REQUIRE(field.as<bool>());
+    REQUIRE(field.as<bool>());
+
+    ini::IniField copy(field);
+    copy = false;
+    REQUIRE_FALSE(copy.as<bool>());
+    REQUIRE(field.as<bool>());
+}
+
+TEST_CASE("decoded values are updated when a multi-line value is continued", "IniFile")
+{
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    inif.decode("[Foo]\nbar=1\n  2");
+
+    REQUIRE(inif["Foo"]["bar"].as<std::string>() == "1\n2");
+    REQUIRE_THROWS(inif["Foo"]["bar"].as<int>());
+}
+
+TEST_CASE("decoded values can be read concurrently", "IniFile")
+{
+    ini::IniField field("12345");
+    ini::IniField other("0.25");
+    std::atomic<bool> failed(false);
+
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&field, &other, &failed, i]() {
+            for(int j = 0; j < 10000; ++j)
+            {
+                // alternate types so that the slot is rewritten all the time
+                if((i + j) % 2 == 0)
+                {
+                    if(field.as<int>() != 12345 || other.as<double>() != 0.25)
+                        failed = true;
+                }
+                else
+                {
+                    if(field.as<double>() != 12345.0 || other.as<float>() != 0.25f)
+                        failed = true;
+                }
+            }
+        });
+    }
+    for(std::thread &thread : threads)
+        thread.join();
+
+    REQUIRE_FALSE(failed);
+}
+
+TEST_CASE("parse integers with base prefixes", "IniFile")
+{
+    std::istringstream ss("[Foo]\n"
+                          "dec=42\n"
+                          "hex=0x2A\n"
+                          "hexupper=0XfF\n"
+                          "oct=052\n"
+                          "bin=0b101010\n"
+                          "zero=0\n"
+                          "neghex=-0x10\n"
+                          "plus=+7");
+    ini::IniFile inif(ss);
+
+    REQUIRE(inif["Foo"]["dec"].as<int>() == 42);
+    REQUIRE(inif["Foo"]["hex"].as<int>() == 42);
+    REQUIRE(inif["Foo"]["hexupper"].as<unsigned short>() == 255);
+    REQUIRE(inif["Foo"]["oct"].as<long>() == 42);
+    REQUIRE(inif["Foo"]["bin"].as<unsigned long>() == 42);
+    REQUIRE(inif["Foo"]["zero"].as<short>() == 0);
+    REQUIRE(inif["Foo"]["neghex"].as<int>() == -16);
+    REQUIRE(inif["Foo"]["plus"].as<unsigned int>() == 7);
+}
+
+TEST_CASE("parse integers at the limits of their type", "IniFile")
+{
+    ini::IniFile inif;
+    inif["Foo"]["shortmin"] = "-32768";
+    inif["Foo"]["shortmax"] = "32767";
+    inif["Foo"]["ushortmax"] = "0xffff";
+    inif["Foo"]["longmin"] = std::to_string(std::numeric_limits<long>::min());
+    inif["Foo"]["ulongmax"] = std::to_string(std::numeric_limits<unsigned long>::max());
+    inif["Foo"]["negzero"] = "-0";
+
+    REQUIRE(inif["Foo"]["shortmin"].as<short>() == -32768);
+    REQUIRE(inif["Foo"]["shortmax"].as<short>() == 32767);
+    REQUIRE(inif["Foo"]["ushortmax"].as<unsigned short>() == 65535);
+    REQUIRE(inif["Foo"]["longmin"].as<long>() == std::numeric_limits<long>::min());
+    REQUIRE(inif["Foo"]["ulongmax"].as<unsigned long>() == std::numeric_limits<unsigned long>::max());
+    REQUIRE(inif["Foo"]["negzero"].as<unsigned int>() == 0);
+}
+
+TEST_CASE("fail to parse integers out of range", "IniFile")
+{
+    ini::IniFile inif;
+    inif["Foo"]["shortover"] = "32768";
+    inif["Foo"]["shortunder"] = "-32769";
+    inif["Foo"]["ushortover"] = "0x10000";
+    inif["Foo"]["negative"] = "-1";
+    inif["Foo"]["huge"] = "123456789012345678901234567890";
+
+    REQUIRE_THROWS_AS(inif["Foo"]["shortover"].as<short>(), std::out_of_range);
+    REQUIRE_THROWS_AS(inif["Foo"]["shortunder"].as<short>(), std::out_of_range);
+    REQUIRE_THROWS_AS(inif["Foo"]["ushortover"].as<unsigned short>(), std::out_of_range);
+    REQUIRE_THROWS_AS(inif["Foo"]["negative"].as<unsigned int>(), std::out_of_range);
+    REQUIRE_THROWS_AS(inif["Foo"]["huge"].as<long>(), std::out_of_range);
+    REQUIRE_THROWS_AS(inif["Foo"]["huge"].as<unsigned long>(), std::out_of_range);
+}
+
+TEST_CASE("fail to parse malformed integers", "IniFile")
+{
+    const char *values[] = {"", "-", "+", "0x", "0b", "08", "0b102", "0xfg", "12a", "1 2", "--1", "+-1", "0x-1", "99999999999999999999999x"};
+    for(const char *value : values)
+    {
+        ini::IniField field(value);
+        REQUIRE_THROWS_AS(field.as<int>(), std::invalid_argument);
+        REQUIRE_THROWS_AS(field.as<unsigned long>(), std::invalid_argument);
+    }
+}
+
+TEST_CASE("parse integers from a character range", "IniFile")
+{
+    const std::string str = "0x7fff, 12";
+    ini::Convert<short> conv;
+    short result = 0;
+
+    conv.decode(str.data(), 6, result);
+    REQUIRE(result == 0x7fff);
+    conv.decode(str.data() + 8, 2, result);
+    REQUIRE(result == 12);
+    REQUIRE_THROWS(conv.decode(str.data(), 7, result));
+
+    long value = 0;
+    REQUIRE(ini::parseInteger(str.data() + 8, str.data() + 10, value) == ini::ParseResult::Ok);
+    REQUIRE(value == 12);
+    REQUIRE(ini::parseInteger(str.data(), str.data() + 10, value) == ini::ParseResult::Invalid);
+}
+
 TEST_CASE("fail to parse as double", "IniFile")
 {
     std::istringstream ss("[Foo]\nbar=bla");
@@ -903,3 +2008,1042 @@ TEST_CASE("parse section with duplicate field and overwriteDuplicateFields_ set
     inif.allowOverwriteDuplicateFields(false);
     REQUIRE_THROWS(inif.decode("[Foo]\nbar=hello\nbar=world"));
 }
+
+/** Records all parser events as strings. */
+struct RecordingHandler : public ini::IniHandler
+{
+    std::vector<std::string> events;
+    // number of events after which the parser is stopped
+    std::size_t stopAfter = std::numeric_limits<std::size_t>::max();
+    bool skipErrors = false;
+
+    bool record(const std::string &event)
+    {
+        events.push_back(event);
+        return events.size() < stopAfter;
+    }
+
+    bool onSection(const ini::StringView name, const int lineNo)
+    {
+        return record(std::to_string(lineNo) + " [" + std::string(name.data(), name.size()) + "]");
+    }
+
+    bool onField(const ini::StringView name, const ini::StringView value, const int lineNo)
+    {
+        return record(std::to_string(lineNo) + " " + std::string(name.data(), name.size()) + "=" +
+            std::string(value.data(), value.size()));
+    }
+
+    bool onComment(const ini::StringView text, const int lineNo)
+    {
+        return record(std::to_string(lineNo) + " #" + std::string(text.data(), text.size()));
+    }
+
+    bool onError(const ini::StringView msg, const int lineNo)
+    {
+        record(std::to_string(lineNo) + " error: " + std::string(msg.data(), msg.size()));
+        return skipErrors;
+    }
+};
+
+TEST_CASE("parser reports events in document order", "IniFile")
+{
+    ini::IniParser parser;
+    RecordingHandler handler;
+    const std::string content = "# header\n[Foo]\nbar = hello  ; greeting\n\n[Baz]\nqux=\\#world\n";
+    REQUIRE(parser.parse(content, handler));
+
+    const std::vector<std::string> expected = {
+        "1 #header", "2 [Foo]", "3 bar=hello", "3 #greeting", "5 [Baz]", "6 qux=#world" };
+    REQUIRE(handler.events == expected);
+}
+
+TEST_CASE("parser stops when the handler returns false", "IniFile")
+{
+    ini::IniParser parser;
+    RecordingHandler handler;
+    handler.stopAfter = 2;
+    REQUIRE_FALSE(parser.parse(std::string("[Foo]\nbar=1\nbaz=2\n[Qux]\n"), handler));
+
+    const std::vector<std::string> expected = { "1 [Foo]", "2 bar=1" };
+    REQUIRE(handler.events == expected);
+}
+
+TEST_CASE("parser stops at errors by default", "IniFile")
+{
+    ini::IniParser parser;
+    RecordingHandler handler;
+    REQUIRE_FALSE(parser.parse(std::string("[Foo\nbar=1\n"), handler));
+
+    const std::vector<std::string> expected = { "1 error: section not closed" };
+    REQUIRE(handler.events == expected);
+}
+
+TEST_CASE("parser skips malformed lines if the handler continues", "IniFile")
+{
+    ini::IniParser parser;
+    RecordingHandler handler;
+    handler.skipErrors = true;
+    REQUIRE(parser.parse(std::string("bar=1\n[]\n[Foo]\nbaz\nqux=2\n"), handler));
+
+    const std::vector<std::string> expected = {
+        "1 error: field has no section or ini file in use by another application",
+        "2 error: section is empty",
+        "3 [Foo]",
+        "4 error: no '=' found",
+        "5 qux=2" };
+    REQUIRE(handler.events == expected);
+}
+
+TEST_CASE("parser reports multi-line values once they are complete", "IniFile")
+{
+    ini::IniParser parser;
+    parser.setMultiLineValues(true);
+    RecordingHandler handler;
+    REQUIRE(parser.parse(std::string("[Foo]\nbar=hello\n  big\n# note\n  world\nbaz=1"), handler));
+
+    const std::vector<std::string> expected = { "1 [Foo]", "4 #note", "2 bar=hello\nbig\nworld", "6 baz=1" };
+    REQUIRE(handler.events == expected);
+}
+
+TEST_CASE("parser uses the configured format", "IniFile")
+{
+    ini::IniParser parser(':', { "//" });
+    parser.setEscapeChar('$');
+    RecordingHandler handler;
+    REQUIRE(parser.parse(std::string("[Foo]\nbar: a $// b // c\n"), handler));
+
+    const std::vector<std::string> expected = { "1 [Foo]", "2 bar=a // b", "2 #c" };
+    REQUIRE(handler.events == expected);
+}
+
+TEST_CASE("parser streams documents across block boundaries", "IniFile")
+{
+    // lines and multi-line values span several blocks of the stream parser
+    std::string content;
+    for(int i = 0; i < 40; ++i)
+    {
+        content += "[section" + std::to_string(i) + "]\n";
+        content += "key = " + std::string(4000, 'a' + (i % 26)) + " \\# ; comment\n";
+        content += "\tcontinued " + std::to_string(i) + "\n";
+        content += "other" + std::string(3000, 'x') + " = value\n";
+    }
+
+    ini::IniParser parser;
+    parser.setMultiLineValues(true);
+    RecordingHandler fromBuffer;
+    REQUIRE(parser.parse(content, fromBuffer));
+    std::istringstream is(content);
+    RecordingHandler fromStream;
+    REQUIRE(parser.parse(is, fromStream));
+
+    REQUIRE(fromBuffer.events.size() == 40 * 4);
+    REQUIRE(fromStream.events == fromBuffer.events);
+}
+
+TEST_CASE("decode from stream equals decode from string", "IniFile")
+{
+    std::string content;
+    for(int i = 0; i < 2000; ++i)
+        content += "[section" + std::to_string(i % 7) + "]\nkey" + std::to_string(i) + " = value " +
+            std::to_string(i) + "\n";
+
+    ini::IniFile fromString;
+    fromString.decode(content);
+    std::istringstream is(content);
+    ini::IniFile fromStream;
+    fromStream.decode(is);
+
+    REQUIRE(fromStream.encode() == fromString.encode());
+}
+
+TEST_CASE("file parser uses the format of the file", "IniFile")
+{
+    ini::IniFile inif;
+    inif.setFieldSep(':');
+    inif.setCommentChar('%');
+    RecordingHandler handler;
+    REQUIRE(inif.parser().parse(std::string("[Foo]\nbar: 1 % x\n"), handler));
+
+    const std::vector<std::string> expected = { "1 [Foo]", "2 bar=1", "2 #x" };
+    REQUIRE(handler.events == expected);
+}
+
+#ifdef INICPP_HAS_THREADS
+/** Creates a document whose sections are repeated and whose fields are
+  * overwritten far apart, so they end up in different chunks. */
+static std::string makeParallelContent(const int sections)
+{
+    std::string content = "# prologue\n\n";
+    for(int i = 0; i < sections; ++i)
+    {
+        content += "[section" + std::to_string(i % 13) + "]\n";
+        content += "  ; comment of section " + std::to_string(i) + "\n";
+        content += "key" + std::to_string(i) + " = value \\# " + std::to_string(i) + "\n";
+        content += "shared = " + std::to_string(i) + "\n";
+        content += "multi = first line\n\tsecond line " + std::to_string(i) + "\n";
+    }
+    return content;
+}
+
+/** Decodes the content and returns the message of the parse error. */
+template<typename File>
+static std::string decodeError(File &inif, const std::string &content)
+{
+    try
+    {
+        inif.decode(content);
+    }
+    catch(const std::logic_error &e)
+    {
+        return e.what();
+    }
+    return "";
+}
+
+TEST_CASE("thread pool runs all tasks", "ThreadPool")
+{
+    ini::ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+    for(int run = 0; run < 10; ++run)
+    {
+        std::vector<std::atomic<int>> calls(100);
+        pool.run(calls.size(), [&](const std::size_t i) { ++calls[i]; });
+        for(const std::atomic<int> &count : calls)
+            REQUIRE(count.load() == 1);
+    }
+}
+
+TEST_CASE("thread pool rethrows exceptions of tasks", "ThreadPool")
+{
+    ini::ThreadPool pool(3);
+    std::atomic<int> calls(0);
+    REQUIRE_THROWS_AS(pool.run(20,
+                          [&](const std::size_t i) {
+                              ++calls;
+                              if(i == 7)
+                                  throw std::runtime_error("task failed");
+                          }),
+        std::runtime_error);
+    REQUIRE(calls.load() == 20);
+
+    pool.run(5, [&](const std::size_t) { ++calls; });
+    REQUIRE(calls.load() == 25);
+}
+
+TEMPLATE_TEST_CASE("parallel decode equals sequential decode", "IniFile", ini::MapStorage, ini::FlatStorage, ini::HashStorage)
+{
+    const std::string content = makeParallelContent(500);
+    std::shared_ptr<ini::ThreadPool> pool = std::make_shared<ini::ThreadPool>(4);
+
+    ini::IniFileBase<std::less<std::string>, TestType> sequential;
+    sequential.setMultiLineValues(true);
+    sequential.decode(content);
+
+    ini::IniFileBase<std::less<std::string>, TestType> parallel;
+    parallel.setMultiLineValues(true);
+    parallel.setThreadPool(pool, 256);
+    parallel.decode(content);
+
+    REQUIRE(parallel.size() == 13);
+    REQUIRE(parallel["section0"]["shared"].template as<int>() == 494);
+    REQUIRE(parallel["section3"]["multi"].template as<std::string>() == "first line\nsecond line 497");
+    REQUIRE(parallel.encode() == sequential.encode());
+}
+
+TEST_CASE("parallel decode merges case insensitive sections", "IniFile")
+{
+    std::string content;
+    for(int i = 0; i < 200; ++i)
+        content += (i % 2 == 0 ? "[Foo]\n" : "[FOO]\n") + std::string("Key") + std::to_string(i % 10) + " = " +
+            std::to_string(i) + "\n";
+
+    ini::IniFileCaseInsensitive parallel;
+    parallel.setThreadPool(std::make_shared<ini::ThreadPool>(4), 64);
+    parallel.decode(content);
+
+    REQUIRE(parallel.size() == 1);
+    REQUIRE(parallel["foo"].size() == 10);
+    REQUIRE(parallel["foo"]["key3"].as<int>() == 193);
+}
+
+TEST_CASE("parallel decode reports the first error with its line number", "IniFile")
+{
+    std::shared_ptr<ini::ThreadPool> pool = std::make_shared<ini::ThreadPool>(4);
+    std::string content = makeParallelContent(300);
+    const std::size_t middle = content.find("[section", content.size() / 2);
+    content.insert(middle, "[section5]\nno separator\n");
+    content += "[broken\n";
+
+    ini::IniFile sequential;
+    sequential.setMultiLineValues(true);
+    const std::string expected = decodeError(sequential, content);
+    REQUIRE(expected.find("no '=' found") != std::string::npos);
+
+    ini::IniFile parallel;
+    parallel.setMultiLineValues(true);
+    parallel.setThreadPool(pool, 256);
+    REQUIRE(decodeError(parallel, content) == expected);
+}
+
+TEST_CASE("parallel decode detects duplicate fields across chunks", "IniFile")
+{
+    std::shared_ptr<ini::ThreadPool> pool = std::make_shared<ini::ThreadPool>(4);
+    std::string content;
+    for(int i = 0; i < 300; ++i)
+        content += "[section" + std::to_string(i) + "]\nkey = " + std::to_string(i) + "\n";
+    // the duplicate is found after merging, the error after it within
+    // the same chunk must not be reported first
+    content += "[section3]\nother = 1\nkey = 2\nno separator\n";
+
+    ini::IniFile sequential;
+    sequential.allowOverwriteDuplicateFields(false);
+    const std::string expected = decodeError(sequential, content);
+    REQUIRE(expected.find("duplicate field found") != std::string::npos);
+
+    ini::IniFile parallel;
+    parallel.allowOverwriteDuplicateFields(false);
+    parallel.setThreadPool(pool, 256);
+    REQUIRE(decodeError(parallel, content) == expected);
+
+    // an error before the duplicate is reported first
+    const std::size_t pos = content.rfind("[section3]");
+    content.insert(pos, "[section299]\nno separator\n");
+    const std::string first = decodeError(sequential, content);
+    REQUIRE(first.find("no '=' found") != std::string::npos);
+    REQUIRE(decodeError(parallel, content) == first);
+}
+
+TEST_CASE("small buffers are decoded sequentially", "IniFile")
+{
+    ini::IniFile inif;
+    inif.setThreadPool(std::make_shared<ini::ThreadPool>(4));
+    inif.decode("[Foo]\nbar=1\n");
+    REQUIRE(inif["Foo"]["bar"].as<int>() == 1);
+}
+#endif
+
+TEST_CASE("diff lists added, removed and changed sections and fields", "IniFile")
+{
+    ini::IniFile from;
+    from.decode("[Same]\na=1\n[Gone]\nx=1\n[Edit]\nkeep=1\nchange=old\ndrop=1\n");
+    ini::IniFile to;
+    to.decode("[Same]\na=1\n[Edit]\nkeep=1\nchange=new\nadd=2\n[New]\ny=2\n");
+
+    const ini::IniDiff changes = ini::diff(from, to);
+    REQUIRE(changes.size() == 7);
+
+    std::vector<std::string> lines;
+    for(const ini::IniChange &change : changes)
+    {
+        const char *type = change.type == ini::ChangeType::Added ? "+" : (change.type == ini::ChangeType::Removed ? "-" : "~");
+        lines.push_back(std::string(type) + change.section + "/" + change.field + ":" + change.oldValue + ">" +
+            change.newValue);
+    }
+    const std::vector<std::string> expected = {
+        "~Edit/change:old>new",
+        "-Edit/drop:1>",
+        "+Edit/add:>2",
+        "-Gone/:>",
+        "-Gone/x:1>",
+        "+New/:>",
+        "+New/y:>2" };
+    REQUIRE(lines == expected);
+    REQUIRE(ini::diff(to, to).empty());
+}
+
+TEST_CASE("diff of case insensitive files ignores the case of names", "IniFile")
+{
+    ini::IniFileCaseInsensitive from;
+    from.decode("[Foo]\nBar=1\n");
+    ini::IniFileCaseInsensitive to;
+    to.decode("[FOO]\nbar=2\n");
+
+    const ini::IniDiff changes = ini::diff(from, to);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].type == ini::ChangeType::Changed);
+    REQUIRE(changes[0].newValue == "2");
+}
+
+TEST_CASE("reloader applies changed files and notifies subscribers", "IniFile")
+{
+    const std::string fileName = "test_reload.ini";
+    writeFile(fileName, "[Server]\nport=80\nhost=localhost\n[Log]\nlevel=info\n");
+
+    ini::IniReloader<ini::IniFile> reloader(fileName);
+    REQUIRE(reloader.file().at("Server").at("port").as<int>() == 80);
+
+    std::vector<std::string> serverEvents;
+    std::vector<std::string> portEvents;
+    std::size_t allEvents = 0;
+    reloader.subscribe("Server", [&](const ini::IniDiff &changes, const ini::IniFile &) {
+        for(const ini::IniChange &change : changes)
+            serverEvents.push_back(change.field);
+    });
+    reloader.subscribe("Server", "port", [&](const ini::IniDiff &changes, const ini::IniFile &file) {
+        REQUIRE(changes.size() == 1);
+        portEvents.push_back(changes[0].newValue);
+        REQUIRE(file.at("Server").at("port").as<std::string>() == changes[0].newValue);
+    });
+    const std::size_t all = reloader.subscribe([&](const ini::IniDiff &changes, const ini::IniFile &) {
+        allEvents += changes.size();
+    });
+
+    // the same contents are not decoded again
+    writeFile(fileName, "[Server]\nport=80\nhost=localhost\n[Log]\nlevel=info\n");
+    const std::uint64_t hash = reloader.contentHash();
+    REQUIRE(reloader.poll(1000).empty());
+    REQUIRE(reloader.contentHash() == hash);
+
+    writeFile(fileName, "[Server]\nport=8080\nhost=localhost\n[Log]\nlevel=debug\n");
+    ini::IniDiff changes = reloader.poll(1000);
+    REQUIRE(changes.size() == 2);
+    REQUIRE(reloader.contentHash() != hash);
+    REQUIRE(serverEvents == std::vector<std::string>{"port"});
+    REQUIRE(portEvents == std::vector<std::string>{"8080"});
+    REQUIRE(allEvents == 2);
+
+    // files which are replaced by a rename are detected as well
+    reloader.unsubscribe(all);
+    writeFile(fileName + ".tmp", "[Server]\nport=8080\n[Log]\nlevel=debug\n");
+    REQUIRE(std::rename((fileName + ".tmp").c_str(), fileName.c_str()) == 0);
+    changes = reloader.poll(1000);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].type == ini::ChangeType::Removed);
+    REQUIRE(serverEvents == std::vector<std::string>{"port", "host"});
+    REQUIRE(portEvents.size() == 1);
+    REQUIRE(allEvents == 2);
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("reloader keeps the current file on errors", "IniFile")
+{
+    const std::string fileName = "test_reload_errors.ini";
+    ini::IniFile prototype;
+    prototype.setFieldSep(':');
+    writeFile(fileName, "[Server]\nport: 80\n");
+    ini::IniReloader<ini::IniFile> reloader(fileName, prototype);
+    REQUIRE(reloader.file().at("Server").at("port").as<int>() == 80);
+
+    writeFile(fileName, "[Server\nport: 81\n");
+    REQUIRE_THROWS_WITH(reloader.reload(), "l.1: ini parsing failed, section not closed");
+    REQUIRE(reloader.file().at("Server").at("port").as<int>() == 80);
+
+    std::remove(fileName.c_str());
+    REQUIRE(reloader.poll(1000).empty());
+    REQUIRE(reloader.file().at("Server").at("port").as<int>() == 80);
+}
+
+#ifdef INICPP_HAS_INOTIFY
+TEST_CASE("file watcher ignores other files in the same directory", "IniFile")
+{
+    const std::string fileName = "test_watch.ini";
+    writeFile(fileName, "[Foo]\n");
+    ini::FileWatcher watcher(fileName);
+    REQUIRE(watcher.isNotifying());
+    REQUIRE_FALSE(watcher.wait(0));
+
+    writeFile("test_watch_other.ini", "[Bar]\n");
+    REQUIRE_FALSE(watcher.wait(100));
+    writeFile(fileName, "[Baz]\n");
+    REQUIRE(watcher.wait(1000));
+    REQUIRE_FALSE(watcher.wait(0));
+
+    std::remove("test_watch_other.ini");
+    std::remove(fileName.c_str());
+}
+#endif
+
+#ifdef INICPP_HAS_THREADS
+TEST_CASE("publisher swaps snapshots", "IniFile")
+{
+    ini::IniFile first;
+    first.decode("[Foo]\nbar=1\n");
+    ini::IniPublisher<ini::IniFile> publisher(first);
+    REQUIRE(publisher.version() == 1);
+
+    ini::IniPublisher<ini::IniFile>::Reader reader = publisher.reader();
+    REQUIRE(reader->at("Foo").at("bar").as<int>() == 1);
+    const ini::IniSnapshot<ini::IniFile> old = publisher.snapshot();
+
+    ini::IniFile second;
+    second.decode("[Foo]\nbar=2\n");
+    publisher.publish(std::move(second));
+    REQUIRE(publisher.version() == 2);
+    REQUIRE(reader->at("Foo").at("bar").as<int>() == 2);
+
+    // snapshots which are still referenced stay valid
+    REQUIRE(old->at("Foo").at("bar").as<int>() == 1);
+}
+
+TEST_CASE("publisher decodes lazily loaded files before publishing", "IniFile")
+{
+    const std::string fileName = "test_publish_lazy.ini";
+    writeFile(fileName, "[Foo]\nbar=1\n[Baz]\nqux=2\n");
+
+    ini::IniFile inif;
+    inif.setLazyLoad(true);
+    inif.load(fileName);
+    REQUIRE(inif.lazySectionCount() == 2);
+
+    ini::IniPublisher<ini::IniFile> publisher(std::move(inif));
+    REQUIRE(publisher.snapshot()->lazySectionCount() == 0);
+    REQUIRE(publisher.snapshot()->at("Baz").at("qux").as<int>() == 2);
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("readers see consistent snapshots while publishing", "IniFile")
+{
+    ini::IniPublisher<ini::IniFile> publisher;
+    std::atomic<bool> done(false);
+    std::atomic<int> inconsistent(0);
+
+    std::vector<std::thread> readers;
+    for(int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]() {
+            ini::IniPublisher<ini::IniFile>::Reader reader = publisher.reader();
+            int last = 0;
+            while(!done.load())
+            {
+                const ini::IniFile &file = reader.get();
+                const auto section = file.find("Foo");
+                if(section == file.end())
+                    continue;
+                // both fields are written with the same value in each version
+                const int a = section->second.at("a").as<int>();
+                const int b = section->second.at("b").as<int>();
+                if(a != b || a < last)
+                    ++inconsistent;
+                last = a;
+            }
+        });
+    }
+
+    for(int i = 1; i <= 500; ++i)
+    {
+        ini::IniFile inif;
+        inif["Foo"]["a"] = i;
+        inif["Foo"]["b"] = i;
+        publisher.publish(std::move(inif));
+    }
+    done = true;
+    for(std::thread &reader : readers)
+        reader.join();
+
+    REQUIRE(inconsistent.load() == 0);
+    REQUIRE(publisher.reader()->at("Foo").at("a").as<int>() == 500);
+}
+#endif
+
+TEMPLATE_TEST_CASE("get does not insert sections or fields", "IniFile", ini::MapStorage, ini::FlatStorage, ini::HashStorage)
+{
+    ini::IniFileBase<std::less<std::string>, TestType> inif;
+    inif.decode("[Foo]\nbar=42\nname=hello\n");
+    const ini::IniFileBase<std::less<std::string>, TestType> &file = inif;
+
+    REQUIRE(file.get("Foo") != nullptr);
+    REQUIRE(file.get("Foo")->size() == 2);
+    REQUIRE(file.get("Missing") == nullptr);
+    REQUIRE(file.get("Foo", "bar") != nullptr);
+    REQUIRE(file.get("Foo", "bar")->template as<int>() == 42);
+    REQUIRE(file.get("Foo", "baz") == nullptr);
+    REQUIRE(file.get("Missing", "bar") == nullptr);
+
+    REQUIRE(file.getOr("Foo", "bar", 7) == 42);
+    REQUIRE(file.getOr("Foo", "baz", 7) == 7);
+    REQUIRE(file.getOr("Missing", "bar", 1.5) == 1.5);
+    REQUIRE(file.getOr("Foo", "name", "default") == "hello");
+    REQUIRE(file.getOr("Foo", "other", "default") == "default");
+    REQUIRE(file.get("Foo")->getOr("bar", 0) == 42);
+    REQUIRE(file.get("Foo")->getOr("baz", std::string("x")) == "x");
+    REQUIRE_THROWS_AS(file.getOr("Foo", "name", 0), std::invalid_argument);
+
+    REQUIRE(inif.size() == 1);
+    REQUIRE(inif["Foo"].size() == 2);
+}
+
+TEST_CASE("get decodes sections of lazily loaded files", "IniFile")
+{
+    const std::string fileName = "test_lazy_get.ini";
+    writeFile(fileName, "[Foo]\nbar=1\n[Baz]\nqux=2\n");
+
+    ini::IniFile inif;
+    inif.setLazyLoad(true);
+    inif.load(fileName);
+    const ini::IniFile &file = inif;
+    REQUIRE(file.lazySectionCount() == 2);
+    REQUIRE(file.getOr("Baz", "qux", 0) == 2);
+    REQUIRE(file.lazySectionCount() == 1);
+    REQUIRE(file.get("Missing") == nullptr);
+    REQUIRE(file.get("Foo", "missing") == nullptr);
+    REQUIRE(file.lazySectionCount() == 0);
+    REQUIRE(file.get("Foo", "bar")->as<int>() == 1);
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("get is case insensitive for case insensitive files", "IniFile")
+{
+    ini::IniFileCaseInsensitive inif;
+    inif.decode("[Foo]\nBar=1\n");
+    REQUIRE(inif.getOr("FOO", "bar", 0) == 1);
+}
+
+#ifdef INICPP_HAS_THREADS
+TEST_CASE("concurrent readers use get without locking", "IniFile")
+{
+    ini::IniFile inif;
+    for(int i = 0; i < 50; ++i)
+        inif["section" + std::to_string(i)]["key"] = i;
+    const ini::IniFile &file = inif;
+
+    std::atomic<int> errors(0);
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]() {
+            for(int n = 0; n < 10000; ++n)
+            {
+                const int i = n % 60;
+                const int value = file.getOr("section" + std::to_string(i), "key", -1);
+                if(value != (i < 50 ? i : -1))
+                    ++errors;
+            }
+        });
+    }
+    for(std::thread &reader : readers)
+        reader.join();
+
+    REQUIRE(errors.load() == 0);
+    REQUIRE(inif.size() == 50);
+}
+#endif
+
+TEMPLATE_TEST_CASE("binary files round trip", "IniFile", ini::MapStorage, ini::FlatStorage, ini::HashStorage)
+{
+    using File = ini::IniFileBase<std::less<std::string>, TestType>;
+    File inif;
+    inif.decode("[Foo]\nbar=42\nname=hello world\nempty=\n[Baz]\npi=3.5\nflag=true\n[Empty]\n");
+
+    const std::string binary = inif.encodeBinary();
+    const ini::IniBinaryView view(binary.data(), binary.size());
+    REQUIRE(view.size() == 3);
+    REQUIRE_FALSE(view.caseInsensitive());
+    REQUIRE(view.bytes() == binary.size());
+
+    REQUIRE(view.get("Foo") != nullptr);
+    REQUIRE(view.get("Foo")->size() == 3);
+    REQUIRE(view.get("foo") == nullptr);
+    REQUIRE(view.get("Missing") == nullptr);
+    REQUIRE(view.get("Foo", "bar")->as<int>() == 42);
+    REQUIRE(view.get("Foo", "missing") == nullptr);
+    REQUIRE(view.getOr("Foo", "bar", 0) == 42);
+    REQUIRE(view.getOr("Foo", "missing", 7) == 7);
+    REQUIRE(view.getOr("Foo", "name", "default") == "hello world");
+    REQUIRE(std::string(view.at("Foo").at("name").as<const char *>()) == "hello world");
+    REQUIRE(view.at("Foo").at("empty").str().empty());
+    REQUIRE(view.at("Baz").at("pi").as<double>() == 3.5);
+    REQUIRE(view.at("Baz").getOr("flag", false));
+    REQUIRE(view.contains("Empty"));
+    REQUIRE(view.at("Empty").empty());
+    REQUIRE(view.find("Missing") == view.end());
+    REQUIRE(view.at("Foo").find("missing") == view.at("Foo").end());
+    REQUIRE_THROWS_AS(view.at("Missing"), std::out_of_range);
+    REQUIRE_THROWS_AS(view.at("Foo").at("missing"), std::out_of_range);
+    REQUIRE_THROWS_AS(view.at("Foo").at("name").as<int>(), std::invalid_argument);
+
+    // sections and fields are iterated in the order of the source file
+    auto section = view.begin();
+    for(const auto &filePair : inif)
+    {
+        REQUIRE(section->name() == filePair.first);
+        auto field = section->begin();
+        for(const auto &secPair : filePair.second)
+        {
+            REQUIRE(field->name() == secPair.first);
+            REQUIRE(field->str() == secPair.second.template as<std::string>());
+            ++field;
+        }
+        REQUIRE(field == section->end());
+        ++section;
+    }
+    REQUIRE(section == view.end());
+
+    File decoded;
+    decoded.decodeBinary(view);
+    REQUIRE(decoded.encode() == inif.encode());
+}
+
+TEST_CASE("binary files of case insensitive files ignore case", "IniFile")
+{
+    ini::IniFileCaseInsensitive inif;
+    inif.decode("[Foo]\nBar=1\n");
+    const std::string binary = inif.encodeBinary();
+    const ini::IniBinaryView view(binary.data(), binary.size());
+
+    REQUIRE(view.caseInsensitive());
+    REQUIRE(view.getOr("FOO", "bar", 0) == 1);
+    REQUIRE(view.get("fOo")->name() == "Foo");
+}
+
+TEST_CASE("binary files with many sections and fields", "IniFile")
+{
+    ini::IniFile inif;
+    for(int i = 0; i < 300; ++i)
+        for(int j = 0; j < 20; ++j)
+            inif["section" + std::to_string(i)]["key" + std::to_string(j)] = i * 100 + j;
+
+    const std::string binary = inif.encodeBinary();
+    const ini::IniBinaryView view(binary.data(), binary.size());
+    REQUIRE(view.size() == 300);
+    for(int i = 0; i < 300; ++i)
+        for(int j = 0; j < 20; ++j)
+            REQUIRE(view.getOr("section" + std::to_string(i), "key" + std::to_string(j), -1) == i * 100 + j);
+    REQUIRE(view.get("section300") == nullptr);
+    REQUIRE(view.get("section1", "key20") == nullptr);
+}
+
+TEST_CASE("binary files of empty files", "IniFile")
+{
+    ini::IniFile inif;
+    const std::string binary = inif.encodeBinary();
+    const ini::IniBinaryView view(binary.data(), binary.size());
+    REQUIRE(view.empty());
+    REQUIRE(view.begin() == view.end());
+    REQUIRE(view.get("Foo") == nullptr);
+
+    const ini::IniBinaryView empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.get("Foo") == nullptr);
+}
+
+TEST_CASE("invalid binary files are rejected", "IniFile")
+{
+    ini::IniFile inif;
+    inif.decode("[Foo]\nbar=42\n");
+    const std::string binary = inif.encodeBinary();
+
+    std::string text = inif.encode();
+    text.resize(std::max(text.size(), binary.size()));
+    REQUIRE_THROWS_AS(ini::IniBinaryView(text.data(), text.size()), std::invalid_argument);
+    REQUIRE_THROWS_AS(ini::IniBinaryView(binary.data(), 10), std::invalid_argument);
+    REQUIRE_THROWS_AS(ini::IniBinaryView(binary.data(), binary.size() - 1), std::invalid_argument);
+
+    std::string corrupt = binary;
+    corrupt[corrupt.size() - 2] = 'X';
+    REQUIRE_THROWS_AS(ini::IniBinaryView(corrupt.data(), corrupt.size()), std::invalid_argument);
+    const ini::IniBinaryView unverified(corrupt.data(), corrupt.size(), false);
+    REQUIRE(unverified.get("Foo", "bar")->str() == "4X");
+}
+
+TEST_CASE("binary files with corrupt records are rejected without verification", "IniFile")
+{
+    ini::IniFile inif;
+    inif.decode("[Foo]\nbar=42\nbaz=hello\n[Qux]\nquux=1\n");
+    const std::string binary = inif.encodeBinary();
+
+    // name offset of the first section
+    std::string corrupt = binary;
+    const std::uint32_t offset = 0x7FFFFFFF;
+    std::memcpy(&corrupt[sizeof(ini::IniBinaryHeader)], &offset, sizeof(offset));
+    REQUIRE_THROWS_AS(ini::IniBinaryView(corrupt.data(), corrupt.size(), false), std::invalid_argument);
+
+    // every corrupted byte of the records is either rejected or read within
+    // the bounds of the file
+    const std::size_t strings = sizeof(ini::IniBinaryHeader) + 2 * (sizeof(ini::IniBinarySection) + 8) +
+        3 * (sizeof(ini::IniBinaryField) + 8);
+    for(std::size_t i = sizeof(ini::IniBinaryHeader); i < strings; ++i)
+    {
+        corrupt = binary;
+        corrupt[i] = static_cast<char>(corrupt[i] ^ 0x5A);
+        try
+        {
+            const ini::IniBinaryView view(corrupt.data(), corrupt.size(), false);
+            std::size_t size = 0;
+            for(const ini::IniBinarySection &section : view)
+                for(const ini::IniBinaryField &field : section)
+                    size += section.name().size() + field.name().size() + field.str().size();
+            view.getOr("Foo", "bar", 0);
+            view.getOr("Qux", "quux", "");
+            REQUIRE(size <= corrupt.size());
+        }
+        catch(const std::invalid_argument &)
+        {
+        }
+    }
+}
+
+TEST_CASE("save and load binary files", "IniFile")
+{
+    const std::string fileName = "test_binary.inib";
+    ini::IniFile inif;
+    inif.decode("[Foo]\nbar=42\n[Baz]\nqux=hello\n");
+    inif.saveBinary(fileName);
+
+    ini::IniBinaryFile file(fileName);
+    REQUIRE(file.size() == 2);
+    REQUIRE(file.getOr("Baz", "qux", "") == "hello");
+
+    ini::IniFile loaded;
+    loaded.loadBinary(fileName);
+    REQUIRE(loaded.encode() == inif.encode());
+
+    file.close();
+    REQUIRE(file.empty());
+    std::remove(fileName.c_str());
+    REQUIRE_THROWS_AS(file.open(fileName), std::invalid_argument);
+    REQUIRE_THROWS_AS(loaded.loadBinary(fileName), std::invalid_argument);
+}
+
+#ifdef INICPP_HAS_CONSTEXPR_PARSE
+static constexpr ini::StaticIniFile staticDefaults(
+    "; defaults\n"
+    "[Server]\n"
+    "port = 8080\n"
+    "host=localhost ; inline comment\n"
+    "name = a \\; b\n"
+    "port = 9090\n"
+    "[Client]\n"
+    "retries=3\n"
+    "[Empty]\n");
+
+static_assert(staticDefaults.size() == 3);
+static_assert(staticDefaults.fieldCount() == 4);
+static_assert(staticDefaults.at("Server", "port") == "9090");
+static_assert(staticDefaults.at("Server", "host") == "localhost");
+static_assert(staticDefaults.at("Server", "name") == "a ; b");
+static_assert(staticDefaults.getOr("Server", "missing", "default") == "default");
+static_assert(staticDefaults.contains("Empty"));
+static_assert(!staticDefaults.contains("Missing"));
+static_assert(!staticDefaults.contains("Server", "retries"));
+static_assert(!staticDefaults.get("Client", "port"));
+
+// the last occurrence of repeated fields wins across repeated sections
+static constexpr ini::StaticIniFile staticRepeated(
+    "[B]\nk=1\n[A]\nk=2\nj=3\n[B]\nk=4\n[A]\nk=5\n[B]\nj=6\nk=7\n[A]\nk=8\n");
+
+static_assert(staticRepeated.size() == 2);
+static_assert(staticRepeated.fieldCount() == 4);
+static_assert(staticRepeated.at("A", "k") == "8");
+static_assert(staticRepeated.at("A", "j") == "3");
+static_assert(staticRepeated.at("B", "k") == "7");
+static_assert(staticRepeated.at("B", "j") == "6");
+
+TEST_CASE("static ini files are parsed at compile time", "IniFile")
+{
+    REQUIRE(staticDefaults.getOr("Client", "retries", 0) == 3);
+    REQUIRE(staticDefaults.getOr("Client", "missing", 5) == 5);
+    REQUIRE(staticDefaults.getOr("Server", "port", std::string()) == "9090");
+    REQUIRE_THROWS_AS(staticDefaults.at("Client", "missing"), std::out_of_range);
+    REQUIRE_THROWS_AS(staticDefaults.getOr("Server", "host", 0), std::invalid_argument);
+}
+
+TEST_CASE("static ini files equal decoded ini files", "IniFile")
+{
+    static constexpr char text[] = "[B]\nz=1\na=2\n[A]\nx = \\#y # c\n\n[B]\nm=3\n";
+    constexpr ini::StaticIniFile<sizeof(text), ini::staticIniCapacity(text)> file(text);
+
+    ini::IniFile inif;
+    inif.decode(text);
+    std::size_t fields = 0;
+    for(const auto &filePair : inif)
+    {
+        REQUIRE(file.contains(filePair.first));
+        for(const auto &secPair : filePair.second)
+        {
+            REQUIRE(file.at(filePair.first, secPair.first) == secPair.second.as<std::string>());
+            ++fields;
+        }
+    }
+    REQUIRE(file.size() == inif.size());
+    REQUIRE(file.fieldCount() == fields);
+}
+
+TEST_CASE("static ini files resolve many repeated entries", "IniFile")
+{
+    // the text is padded with line breaks to the size of the table
+    static char text[8192];
+    std::string content;
+    std::mt19937 generator(7);
+    for(int i = 0; i < 60; ++i)
+    {
+        content += "[section" + std::to_string(generator() % 9) + "]\n";
+        for(unsigned int j = generator() % 8; j != 0; --j)
+            content += "field" + std::to_string(generator() % 12) + "=" + std::to_string(i * 10 + j) + "\n";
+    }
+    REQUIRE(content.size() < sizeof(text));
+    std::memset(text, '\n', sizeof(text) - 1);
+    std::memcpy(text, content.data(), content.size());
+
+    using File = ini::StaticIniFile<sizeof(text), 512>;
+    std::unique_ptr<File> file(new File(text));
+    ini::IniFile inif;
+    inif.decode(content);
+    std::size_t fields = 0;
+    for(const auto &filePair : inif)
+    {
+        REQUIRE(file->contains(filePair.first));
+        for(const auto &secPair : filePair.second)
+        {
+            REQUIRE(file->at(filePair.first, secPair.first) == secPair.second.as<std::string>());
+            ++fields;
+        }
+    }
+    REQUIRE(file->size() == inif.size());
+    REQUIRE(file->fieldCount() == fields);
+}
+
+TEST_CASE("invalid static ini files throw", "IniFile")
+{
+    REQUIRE_THROWS_AS(ini::StaticIniFile("[Foo\n"), std::logic_error);
+    REQUIRE_THROWS_AS(ini::StaticIniFile("[]\n"), std::logic_error);
+    REQUIRE_THROWS_AS(ini::StaticIniFile("foo=bar\n"), std::logic_error);
+    REQUIRE_THROWS_AS(ini::StaticIniFile("[Foo]\nbar\n"), std::logic_error);
+    REQUIRE_THROWS_AS((ini::StaticIniFile<9, 1>("[A]\n[B]\n")), std::length_error);
+}
+
+static_assert(test::embedded_defaults.at("Server", "port") == "8080");
+
+TEST_CASE("embedded ini files are generated at build time", "IniFile")
+{
+    REQUIRE(test::embedded_defaults.size() == 2);
+    REQUIRE(test::embedded_defaults.getOr("Server", "timeout", 0.0) == 2.5);
+    REQUIRE(test::embedded_defaults.at("Paths", "data") == "/var/lib/inicpp # not a comment");
+}
+#endif
+
+struct BindConfig
+{
+    std::string host;
+    int port = 0;
+    double timeout = 0.0;
+    bool verbose = false;
+    unsigned int retries = 7;
+    std::string name;
+};
+
+static ini::IniSchema<BindConfig> bindSchema()
+{
+    ini::IniSchema<BindConfig> schema;
+    schema.required("Server", "host", &BindConfig::host)
+        .optional("Server", "port", &BindConfig::port, 8080)
+        .optional("Server", "timeout", &BindConfig::timeout, 1.5)
+        .required("Client", "verbose", &BindConfig::verbose)
+        .optional("Client", "retries", &BindConfig::retries)
+        .optional("Client", "name", &BindConfig::name, "client");
+    return schema;
+}
+
+TEST_CASE("bind ini file to struct", "IniFile")
+{
+    const ini::IniSchema<BindConfig> schema = bindSchema();
+    REQUIRE(schema.size() == 6);
+
+    BindConfig config;
+    const ini::IniBindResult result = schema.decode(
+        "[Server]\nhost = example.com\nport=9000\n[Client]\nverbose=true\nname=a \\# b\n", config);
+    REQUIRE(result.unknown.empty());
+    REQUIRE(result.missing.empty());
+    REQUIRE(config.host == "example.com");
+    REQUIRE(config.port == 9000);
+    REQUIRE(config.timeout == 1.5);
+    REQUIRE(config.verbose);
+    REQUIRE(config.retries == 7);
+    REQUIRE(config.name == "a # b");
+}
+
+TEST_CASE("bind reports unknown and missing fields", "IniFile")
+{
+    const ini::IniSchema<BindConfig> schema = bindSchema();
+
+    BindConfig config;
+    config.port = 1;
+    const ini::IniBindResult result = schema.decode(
+        "[Server]\nhost=a\nextra=1\n[Other]\nfoo=bar\nbaz=qux\n[Server]\nmore=2\n", config);
+    REQUIRE(config.host == "a");
+    REQUIRE(config.port == 8080);
+
+    REQUIRE(result.unknown.size() == 3);
+    REQUIRE(result.unknown[0].section == "Server");
+    REQUIRE(result.unknown[0].field == "extra");
+    REQUIRE(result.unknown[0].lineNo == 3);
+    REQUIRE(result.unknown[1].section == "Other");
+    REQUIRE(result.unknown[1].field.empty());
+    REQUIRE(result.unknown[1].lineNo == 4);
+    REQUIRE(result.unknown[2].field == "more");
+    REQUIRE(result.unknown[2].lineNo == 8);
+
+    REQUIRE(result.missing.size() == 1);
+    REQUIRE(result.missing[0].section == "Client");
+    REQUIRE(result.missing[0].field == "verbose");
+}
+
+TEST_CASE("bind reports conversion and parse errors", "IniFile")
+{
+    const ini::IniSchema<BindConfig> schema = bindSchema();
+    BindConfig config;
+
+    try
+    {
+        schema.decode("[Server]\nhost=a\nport=abc\n", config);
+        FAIL("conversion error not thrown");
+    }
+    catch(const std::invalid_argument &e)
+    {
+        REQUIRE(std::string(e.what()) == "l.3: Server.port: field is not an int");
+    }
+    REQUIRE_THROWS_AS(schema.decode("[Server]\nport=99999999999\n", config), std::out_of_range);
+    REQUIRE_THROWS_AS(schema.decode("[Server\n", config), std::logic_error);
+    REQUIRE_THROWS_AS(ini::IniSchema<BindConfig>().required("A", "b", &BindConfig::port).optional("A", "b", &BindConfig::name),
+        std::invalid_argument);
+}
+
+TEST_CASE("encode struct with schema", "IniFile")
+{
+    const ini::IniSchema<BindConfig> schema = bindSchema();
+    BindConfig config;
+    config.host = "example.com ; x";
+    config.port = 80;
+    config.timeout = 0.25;
+    config.verbose = true;
+    config.retries = 3;
+    config.name = "client";
+
+    const std::string encoded = schema.encode(config);
+    REQUIRE(encoded ==
+        "[Server]\nhost=example.com \\; x\nport=80\ntimeout=0.25\n\n"
+        "[Client]\nverbose=true\nretries=3\nname=client\n\n");
+
+    BindConfig decoded;
+    const ini::IniBindResult result = schema.decode(encoded, decoded);
+    REQUIRE(result.unknown.empty());
+    REQUIRE(result.missing.empty());
+    REQUIRE(decoded.host == config.host);
+    REQUIRE(decoded.port == config.port);
+    REQUIRE(decoded.timeout == config.timeout);
+    REQUIRE(decoded.retries == config.retries);
+
+    ini::IniFile inif;
+    inif.decode(encoded);
+    REQUIRE(inif["Server"]["host"].as<std::string>() == config.host);
+}
+
+TEST_CASE("bind with custom syntax and case insensitive names", "IniFile")
+{
+    ini::IniParser parser;
+    parser.setFieldSep(':');
+    ini::IniSchema<BindConfig, ini::StringInsensitiveLess> schema(parser);
+    schema.required("Server", "Host", &BindConfig::host).optional("Server", "port", &BindConfig::port);
+
+    BindConfig config;
+    std::istringstream ss("[SERVER]\nhost: a\nPORT: 5\n");
+    const ini::IniBindResult result = schema.decode(ss, config);
+    REQUIRE(result.unknown.empty());
+    REQUIRE(result.missing.empty());
+    REQUIRE(config.host == "a");
+    REQUIRE(config.port == 5);
+    REQUIRE(schema.encode(config) == "[Server]\nHost:a\nport:5\n\n");
+}
@@ -0,0 +1,327 @@
+/*
+ * test_stats.cpp
+ *
+ * Created on: 18 Oct 2026
+ *     Author: Fabian Meyer
+ *    License: MIT
+ */
+
+#include "inicpp.h"
+#include "allocation_counter.h"
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <sstream>
+
+/** Records the statistics of all decodes and encodes. */
+class RecordingObserver : public ini::IniObserver
+{
+public:
+    std::vector<ini::IniStats> decodes;
+    std::vector<ini::IniStats> encodes;
+    bool countAllocations = false;
+
+    void onDecode(const ini::IniStats &stats) override
+    {
+        decodes.push_back(stats);
+    }
+
+    void onEncode(const ini::IniStats &stats) override
+    {
+        encodes.push_back(stats);
+    }
+
+    ini::IniAllocationCount allocations() const override
+    {
+        ini::IniAllocationCount count;
+        if(countAllocations)
+        {
+            count.count = allocationCount();
+            count.bytes = allocatedBytes();
+        }
+        return count;
+    }
+};
+
+static const char *statsContent()
+{
+    return "# prologue\n"
+           "[Foo]\n"
+           "bar=hello world ; comment\n"
+           "text=first\n"
+           "  second\n"
+           "  third\n"
+           "\n"
+           "[Esc\\#aped]\n"
+           "a\\;b=c\\#d\n"
+           "[Foo]\n"
+           "bar=overwritten\n"
+           "baz=42";
+}
+
+/** Checks the counters of a decode of statsContent(). */
+static void requireStatsCounters(const ini::IniStats &stats)
+{
+    REQUIRE(stats.bytes == std::strlen(statsContent()));
+    REQUIRE(stats.lines == 12);
+    REQUIRE(stats.sections == 2);
+    REQUIRE(stats.fields == 4);
+    REQUIRE(stats.comments == 2);
+    REQUIRE(stats.continuations == 2);
+    REQUIRE(stats.duplicates == 1);
+}
+
+/** Checks that the phases of a sequential operation fit into its total time. */
+static void requirePhases(const ini::IniStats &stats)
+{
+    REQUIRE(stats.readTime.count() >= 0);
+    REQUIRE(stats.tokenizeTime.count() >= 0);
+    REQUIRE(stats.insertTime.count() >= 0);
+    REQUIRE(stats.convertTime.count() >= 0);
+    REQUIRE(stats.readTime + stats.tokenizeTime + stats.insertTime + stats.convertTime <= stats.totalTime);
+}
+
+TEST_CASE("decode reports counters and phases", "Stats")
+{
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    inif.setObserver(observer);
+    inif.decode(statsContent());
+
+    REQUIRE(observer->decodes.size() == 1);
+    REQUIRE(observer->encodes.empty());
+    const ini::IniStats &stats = observer->decodes[0];
+    requireStatsCounters(stats);
+    requirePhases(stats);
+    REQUIRE(stats.readTime.count() == 0);
+    REQUIRE(stats.allocations == 0);
+    REQUIRE(stats.allocatedBytes == 0);
+
+    REQUIRE(inif["Foo"]["text"].as<std::string>() == "first\nsecond\nthird");
+    REQUIRE(inif["Esc#aped"]["a;b"].as<std::string>() == "c#d");
+}
+
+TEST_CASE("stream decode reports the same counters", "Stats")
+{
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    inif.setObserver(observer);
+
+    std::istringstream is(statsContent());
+    inif.decode(is);
+
+    REQUIRE(observer->decodes.size() == 1);
+    requireStatsCounters(observer->decodes[0]);
+    requirePhases(observer->decodes[0]);
+}
+
+TEST_CASE("file without observer reports nothing", "Stats")
+{
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile inif;
+    inif.setObserver(observer);
+    inif.setObserver(nullptr);
+    inif.decode("[Foo]\nbar=1\n");
+    inif.encode();
+
+    REQUIRE(inif.observer() == nullptr);
+    REQUIRE(observer->decodes.empty());
+    REQUIRE(observer->encodes.empty());
+    REQUIRE(inif["Foo"]["bar"].as<int>() == 1);
+}
+
+TEST_CASE("failed decode reports nothing", "Stats")
+{
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile inif;
+    inif.allowOverwriteDuplicateFields(false);
+    inif.setObserver(observer);
+
+    REQUIRE_THROWS_AS(inif.decode("[Foo]\nbar=1\nbar=2\n"), std::logic_error);
+    REQUIRE_THROWS_AS(inif.decode("bar=1\n"), std::logic_error);
+    REQUIRE(observer->decodes.empty());
+}
+
+TEST_CASE("copies share the observer", "Stats")
+{
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile inif;
+    inif.setObserver(observer);
+    ini::IniFile copy = inif;
+    copy.decode("[Foo]\nbar=1\n");
+
+    REQUIRE(copy.observer() == inif.observer());
+    REQUIRE(observer->decodes.size() == 1);
+    REQUIRE(observer->decodes[0].fields == 1);
+}
+
+TEST_CASE("encode reports counters", "Stats")
+{
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    inif.decode(statsContent());
+    inif.setObserver(observer);
+    const std::string encoded = inif.encode();
+
+    REQUIRE(observer->decodes.empty());
+    REQUIRE(observer->encodes.size() == 1);
+    const ini::IniStats &stats = observer->encodes[0];
+    REQUIRE(stats.bytes == encoded.size());
+    REQUIRE(stats.lines == static_cast<std::size_t>(std::count(encoded.begin(), encoded.end(), '\n')));
+    REQUIRE(stats.sections == 2);
+    REQUIRE(stats.fields == 4);
+    REQUIRE(stats.continuations == 2);
+    REQUIRE(stats.comments == 0);
+    REQUIRE(stats.duplicates == 0);
+    REQUIRE(stats.convertTime.count() > 0);
+    requirePhases(stats);
+}
+
+TEST_CASE("load reports the read phase", "Stats")
+{
+    const std::string fileName = "test_stats_load.ini";
+    {
+        std::ofstream os(fileName.c_str(), std::ios::binary);
+        os << statsContent();
+    }
+
+    const ini::LoadMode modes[] = {ini::LoadMode::Stream, ini::LoadMode::Mapped};
+    for(const ini::LoadMode mode : modes)
+    {
+        std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+        ini::IniFile inif;
+        inif.setMultiLineValues(true);
+        inif.setLoadMode(mode);
+        inif.setObserver(observer);
+        inif.load(fileName);
+
+        REQUIRE(observer->decodes.size() == 1);
+        requireStatsCounters(observer->decodes[0]);
+        requirePhases(observer->decodes[0]);
+        REQUIRE(observer->decodes[0].readTime.count() > 0);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("lazy load reports each decoded section", "Stats")
+{
+    const std::string fileName = "test_stats_lazy.ini";
+    {
+        std::ofstream os(fileName.c_str(), std::ios::binary);
+        os << statsContent();
+    }
+
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile inif;
+    inif.setMultiLineValues(true);
+    inif.setLazyLoad(true);
+    inif.setObserver(observer);
+    inif.load(fileName);
+
+    REQUIRE(observer->decodes.size() == 1);
+    REQUIRE(observer->decodes[0].bytes == std::strlen(statsContent()));
+    REQUIRE(observer->decodes[0].sections == 2);
+    REQUIRE(observer->decodes[0].fields == 0);
+
+    // both occurrences of the section are decoded at once
+    REQUIRE(inif["Foo"]["bar"].as<std::string>() == "overwritten");
+    REQUIRE(observer->decodes.size() == 2);
+    REQUIRE(observer->decodes[1].sections == 0);
+    REQUIRE(observer->decodes[1].fields == 3);
+    REQUIRE(observer->decodes[1].duplicates == 1);
+    REQUIRE(observer->decodes[1].continuations == 2);
+    REQUIRE(observer->decodes[1].comments == 1);
+
+    inif.decodeAll();
+    REQUIRE(observer->decodes.size() == 3);
+    REQUIRE(observer->decodes[2].fields == 1);
+    REQUIRE(observer->decodes[2].lines == 2);
+
+    std::remove(fileName.c_str());
+}
+
+#ifdef INICPP_HAS_THREADS
+TEST_CASE("parallel decode reports the counters of a sequential decode", "Stats")
+{
+    std::string content;
+    for(int i = 0; i < 300; ++i)
+    {
+        content += "[section" + std::to_string(i % 7) + "]\n";
+        content += "shared = " + std::to_string(i) + " # comment\n";
+        content += "field" + std::to_string(i) + " = value\n";
+        content += "multi = first\n  second\n";
+    }
+
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    ini::IniFile sequential;
+    sequential.setMultiLineValues(true);
+    sequential.setObserver(observer);
+    sequential.decode(content);
+
+    ini::IniFile parallel;
+    parallel.setMultiLineValues(true);
+    parallel.setObserver(observer);
+    parallel.setThreadPool(std::make_shared<ini::ThreadPool>(4), 256);
+    parallel.decode(content);
+
+    REQUIRE(observer->decodes.size() == 2);
+    const ini::IniStats &expected = observer->decodes[0];
+    const ini::IniStats &actual = observer->decodes[1];
+    REQUIRE(expected.sections == 7);
+    REQUIRE(expected.fields == 7 * 2 + 300);
+    REQUIRE(expected.duplicates == 2 * 300 - 7 * 2);
+    REQUIRE(actual.bytes == expected.bytes);
+    REQUIRE(actual.lines == expected.lines);
+    REQUIRE(actual.sections == expected.sections);
+    REQUIRE(actual.fields == expected.fields);
+    REQUIRE(actual.comments == expected.comments);
+    REQUIRE(actual.continuations == expected.continuations);
+    REQUIRE(actual.duplicates == expected.duplicates);
+    REQUIRE(parallel.encode() == sequential.encode());
+}
+#endif
+
+TEST_CASE("parser adds statistics of custom handlers", "Stats")
+{
+    ini::IniParser parser;
+    parser.setMultiLineValues(true);
+    ini::IniHandler handler;
+    ini::IniStats stats;
+    REQUIRE(parser.parse(statsContent(), std::strlen(statsContent()), handler, stats));
+
+    // the handler does not count sections, fields and comments
+    REQUIRE(stats.bytes == std::strlen(statsContent()));
+    REQUIRE(stats.lines == 12);
+    REQUIRE(stats.continuations == 2);
+    REQUIRE(stats.fields == 0);
+    REQUIRE(stats.tokenizeTime.count() > 0);
+}
+
+TEST_CASE("decode reports allocations of the observer", "Stats")
+{
+    std::stringstream ss;
+    for(int i = 0; i < 10; ++i)
+    {
+        ss << "[a section with a long name " << i << "]\n";
+        for(int j = 0; j < 20; ++j)
+            ss << "a field with a long name " << j << " = a value with a long text " << j << '\n';
+    }
+    const std::string content = ss.str();
+
+    std::shared_ptr<RecordingObserver> observer = std::make_shared<RecordingObserver>();
+    observer->countAllocations = true;
+    ini::IniFile inif;
+    inif.setObserver(observer);
+    inif.decode(content);
+
+    // one tree node and one name per section, one tree node, one name and
+    // one value per field
+    REQUIRE(observer->decodes.size() == 1);
+    const ini::IniStats &stats = observer->decodes[0];
+    REQUIRE_ALLOCATIONS(stats.allocations == 10 * 2 + 10 * 20 * 3);
+    REQUIRE(stats.allocations >= 10 + 10 * 20 * 2);
+    REQUIRE(stats.allocatedBytes >= 10 * 20 * 2 * 25);
+}